@@ -16,12 +16,14 @@ from esphome.const import (
     CONF_EVENT,
     CONF_TAG,
 )
-from esphome.core import coroutine_with_priority
+from esphome.core import CORE, coroutine_with_priority
 
 DEPENDENCIES = ["network"]
 AUTO_LOAD = ["async_tcp"]
 CODEOWNERS = ["@OttoWinter"]
 
+CONF_RECV_BUFFER_SIZE = "recv_buffer_size"
+
 api_ns = cg.esphome_ns.namespace("api")
 APIServer = api_ns.class_("APIServer", cg.Component, cg.Controller)
 HomeAssistantServiceCallAction = api_ns.class_(
@@ -42,6 +44,27 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 
+# lwIP TCP receive window: 4 * 1460 byte MSS with the lwIP2 variant core_config selects on ESP8266
+TCP_RECV_WINDOW_ESP8266 = 5840
+TCP_RECV_WINDOW_ESP32 = 5744
+
+
+def tcp_recv_window():
+    return TCP_RECV_WINDOW_ESP32 if CORE.is_esp32 else TCP_RECV_WINDOW_ESP8266
+
+
+def validate_recv_buffer_size(value):
+    value = cv.int_range(max=32768)(value)
+    # All data in the buffer is unacknowledged, so a client can't send more than the
+    # TCP window. A smaller buffer could overflow before the window closes.
+    if value < tcp_recv_window():
+        raise cv.Invalid(
+            "recv_buffer_size must be at least the TCP receive window of {} bytes"
+            "".format(tcp_recv_window())
+        )
+    return value
+
+
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(APIServer),
@@ -50,6 +73,7 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(
             CONF_REBOOT_TIMEOUT, default="15min"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_RECV_BUFFER_SIZE): validate_recv_buffer_size,
         cv.Optional(CONF_SERVICES): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(UserServiceTrigger),
@@ -75,6 +99,10 @@ def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    # Default to the lwIP TCP receive window, so that holding back ACKs keeps
+    # the client from ever sending more than fits into the buffer
+    recv_buffer_size = config.get(CONF_RECV_BUFFER_SIZE, tcp_recv_window())
+    cg.add(var.set_recv_buffer_size(recv_buffer_size))
 
     for conf in config.get(CONF_SERVICES, []):
         template_args = []
@@ -12,12 +12,18 @@
 #ifdef USE_FAN
 #include "esphome/components/fan/fan_helpers.h"
 #endif
+#ifdef USE_LOGGER
+#include "esphome/components/logger/logger.h"
+#endif
 
 namespace esphome {
 namespace api {
 
 static const char *TAG = "api.connection";
 
+/// Maximum number of entities each iterator sends per loop() call.
+static const uint8_t ITERATOR_BATCH_SIZE = 16;
+
 APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
     : client_(client), parent_(parent), initial_state_iterator_(parent, this), list_entities_iterator_(parent, this) {
   this->client_->onError([](void *s, AsyncClient *c, int8_t error) { ((APIConnection *) s)->on_error_(error); }, this);
@@ -28,60 +34,82 @@ APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
                            size_t len) { ((APIConnection *) s)->on_data_(reinterpret_cast<uint8_t *>(buf), len); },
                         this);
 
-  this->send_buffer_.reserve(64);
-  this->recv_buffer_.reserve(32);
+  this->send_buffer_.reserve(64 + FRAME_HEADER_PADDING);
+  this->recv_buffer_.init(parent->get_recv_buffer_size());
   this->client_info_ = this->client_->remoteIP().toString().c_str();
   this->last_traffic_ = millis();
 }
 APIConnection::~APIConnection() { delete this->client_; }
-void APIConnection::on_error_(int8_t error) { this->remove_ = true; }
-void APIConnection::on_disconnect_() { this->remove_ = true; }
-void APIConnection::on_timeout_(uint32_t time) { this->on_fatal_error(); }
+// usually called from the lwIP/async_tcp context, wake the main loop so the connection is removed right away
+void APIConnection::on_error_(int8_t error) {
+  this->remove_ = true;
+  App.wake_loop_any_context();
+}
+void APIConnection::on_disconnect_() {
+  this->remove_ = true;
+  App.wake_loop_any_context();
+}
+void APIConnection::on_timeout_(uint32_t time) {
+  this->on_fatal_error();
+  App.wake_loop_any_context();
+}
 void APIConnection::on_data_(uint8_t *buf, size_t len) {
   if (len == 0 || buf == nullptr)
     return;
-  this->recv_buffer_.insert(this->recv_buffer_.end(), buf, buf + len);
+  // Only acknowledge the data once it has been parsed, this way a busy main loop
+  // shrinks the TCP window and throttles the client instead of growing the buffer.
+  this->client_->ackLater();
+  if (!this->recv_buffer_.write(buf, len)) {
+    // everything in the buffer is unacknowledged and the buffer is at least as large as the TCP window,
+    // so this only happens if the client ignores the window.
+    // can't log here because in lwIP thread, reported in loop()
+    this->recv_overflow_ = true;
+    return;
+  }
+  // handle the request right away instead of after the main loop's sleep
+  App.wake_loop_any_context();
 }
 void APIConnection::parse_recv_buffer_() {
-  if (this->recv_buffer_.empty() || this->remove_)
+  if (this->remove_)
     return;
 
+  if (this->recv_overflow_) {
+    ESP_LOGW(TAG, "Receive buffer of %s overflowed (%u bytes)", this->client_info_.c_str(),
+             this->recv_buffer_.capacity());
+    this->on_fatal_error();
+    return;
+  }
+
   while (!this->recv_buffer_.empty()) {
-    if (this->recv_buffer_[0] != 0x00) {
+    uint32_t msg_type;
+    uint8_t *msg;
+    uint32_t msg_size;
+    auto status = this->recv_buffer_.next_frame(&msg_type, &msg, &msg_size);
+    if (status == APIRecvBuffer::FrameStatus::INCOMPLETE)
+      // not enough data there yet
+      break;
+    if (status == APIRecvBuffer::FrameStatus::BAD_PREAMBLE) {
       ESP_LOGW(TAG, "Invalid preamble from %s", this->client_info_.c_str());
       this->on_fatal_error();
       return;
     }
-    uint32_t i = 1;
-    const uint32_t size = this->recv_buffer_.size();
-    uint32_t consumed;
-    auto msg_size_varint = ProtoVarInt::parse(&this->recv_buffer_[i], size - i, &consumed);
-    if (!msg_size_varint.has_value())
-      // not enough data there yet
-      return;
-    i += consumed;
-    uint32_t msg_size = msg_size_varint->as_uint32();
-
-    auto msg_type_varint = ProtoVarInt::parse(&this->recv_buffer_[i], size - i, &consumed);
-    if (!msg_type_varint.has_value())
-      // not enough data there yet
-      return;
-    i += consumed;
-    uint32_t msg_type = msg_type_varint->as_uint32();
-
-    if (size - i < msg_size)
-      // message body not fully received
+    if (status == APIRecvBuffer::FrameStatus::BAD_HEADER) {
+      ESP_LOGW(TAG, "Invalid message header from %s", this->client_info_.c_str());
+      this->on_fatal_error();
       return;
+    }
 
-    uint8_t *msg = &this->recv_buffer_[i];
     this->read_message(msg_size, msg_type, msg);
     if (this->remove_)
       return;
-    // pop front
-    uint32_t total = i + msg_size;
-    this->recv_buffer_.erase(this->recv_buffer_.begin(), this->recv_buffer_.begin() + total);
+    this->recv_buffer_.consume_frame();
     this->last_traffic_ = millis();
   }
+
+  // includes the parts of frames larger than the buffer that were moved out of it
+  const size_t acked = this->recv_buffer_.take_released();
+  if (acked != 0)
+    this->client_->ack(acked);
 }
 
 void APIConnection::disconnect_client() {
@@ -109,10 +137,24 @@ void APIConnection::loop() {
     this->on_disconnect_();
     return;
   }
+  // responses and the entity iterators are collected into as few TCP writes as possible
+  this->batch_ = true;
+  this->batch_send_failed_ = false;
   this->parse_recv_buffer_();
+  this->flush_pending_states_();
 
-  this->list_entities_iterator_.advance();
-  this->initial_state_iterator_.advance();
+  for (uint8_t i = 0; i < ITERATOR_BATCH_SIZE && !this->batch_send_failed_; i++) {
+    if (this->list_entities_iterator_.completed())
+      break;
+    this->list_entities_iterator_.advance();
+  }
+  for (uint8_t i = 0; i < ITERATOR_BATCH_SIZE && !this->batch_send_failed_; i++) {
+    if (this->initial_state_iterator_.completed())
+      break;
+    this->initial_state_iterator_.advance();
+  }
+  this->batch_ = false;
+  this->flush_batch_();
 
   const uint32_t keepalive = 60000;
   if (this->sent_ping_) {
@@ -133,6 +175,7 @@ void APIConnection::loop() {
     if (space >= 15 + 64) {
       uint32_t to_send = std::min(space - 15, this->image_reader_.available());
       auto buffer = this->create_buffer();
+      buffer.reserve(15 + to_send);
       // fixed32 key = 1;
       buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
       // bytes data = 2;
@@ -153,6 +196,18 @@ void APIConnection::loop() {
 #endif
 }
 
+bool APIConnection::is_idle() const {
+  if (this->remove_ || this->next_close_ || !this->pending_states_.empty())
+    return false;
+  if (!this->list_entities_iterator_.completed() || !this->initial_state_iterator_.completed())
+    return false;
+#ifdef USE_ESP32_CAMERA
+  if (this->image_reader_.available())
+    return false;
+#endif
+  return true;
+}
+
 std::string get_default_unique_id(const std::string &component_type, Nameable *nameable) {
   return App.get_name() + component_type + nameable->get_object_id();
 }
@@ -166,7 +221,8 @@ bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary
   resp.key = binary_sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !binary_sensor->has_state();
-  return this->send_binary_sensor_state_response(resp);
+  return this->track_state_(binary_sensor, PendingStateType::BINARY_SENSOR,
+                            this->send_binary_sensor_state_response(resp));
 }
 bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor) {
   ListEntitiesBinarySensorResponse msg;
@@ -194,7 +250,7 @@ bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (traits.get_supports_tilt())
     resp.tilt = cover->tilt;
   resp.current_operation = static_cast<enums::CoverOperation>(cover->current_operation);
-  return this->send_cover_state_response(resp);
+  return this->track_state_(cover, PendingStateType::COVER, this->send_cover_state_response(resp));
 }
 bool APIConnection::send_cover_info(cover::Cover *cover) {
   auto traits = cover->get_traits();
@@ -255,7 +311,7 @@ bool APIConnection::send_fan_state(fan::FanState *fan) {
   }
   if (traits.supports_direction())
     resp.direction = static_cast<enums::FanDirection>(fan->direction);
-  return this->send_fan_state_response(resp);
+  return this->track_state_(fan, PendingStateType::FAN, this->send_fan_state_response(resp));
 }
 bool APIConnection::send_fan_info(fan::FanState *fan) {
   auto traits = fan->get_traits();
@@ -318,7 +374,7 @@ bool APIConnection::send_light_state(light::LightState *light) {
     resp.color_temperature = values.get_color_temperature();
   if (light->supports_effects())
     resp.effect = light->get_effect_name();
-  return this->send_light_state_response(resp);
+  return this->track_state_(light, PendingStateType::LIGHT, this->send_light_state_response(resp));
 }
 bool APIConnection::send_light_info(light::LightState *light) {
   auto traits = light->get_traits();
@@ -380,7 +436,7 @@ bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   resp.key = sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !sensor->has_state();
-  return this->send_sensor_state_response(resp);
+  return this->track_state_(sensor, PendingStateType::SENSOR, this->send_sensor_state_response(resp));
 }
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
   ListEntitiesSensorResponse msg;
@@ -407,7 +463,7 @@ bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
   resp.state = state;
-  return this->send_switch_state_response(resp);
+  return this->track_state_(a_switch, PendingStateType::SWITCH, this->send_switch_state_response(resp));
 }
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   ListEntitiesSwitchResponse msg;
@@ -440,7 +496,7 @@ bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor,
   resp.key = text_sensor->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !text_sensor->has_state();
-  return this->send_text_sensor_state_response(resp);
+  return this->track_state_(text_sensor, PendingStateType::TEXT_SENSOR, this->send_text_sensor_state_response(resp));
 }
 bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor) {
   ListEntitiesTextSensorResponse msg;
@@ -479,7 +535,7 @@ bool APIConnection::send_climate_state(climate::Climate *climate) {
     resp.fan_mode = static_cast<enums::ClimateFanMode>(climate->fan_mode);
   if (traits.get_supports_swing_modes())
     resp.swing_mode = static_cast<enums::ClimateSwingMode>(climate->swing_mode);
-  return this->send_climate_state_response(resp);
+  return this->track_state_(climate, PendingStateType::CLIMATE, this->send_climate_state_response(resp));
 }
 bool APIConnection::send_climate_info(climate::Climate *climate) {
   auto traits = climate->get_traits();
@@ -595,6 +651,34 @@ bool APIConnection::send_log_message(int level, const char *tag, const char *lin
   }
 }
 
+#ifdef USE_RUNTIME_STATS
+static RuntimeStatsEntry make_runtime_stats_entry(const runtime_stats::RuntimeStatsEntry &entry) {
+  RuntimeStatsEntry msg;
+  msg.name = entry.name;
+  msg.count = entry.count;
+  msg.min_us = entry.min_us;
+  msg.avg_us = entry.avg_us;
+  msg.max_us = entry.max_us;
+  msg.p99_us = entry.p99_us;
+  msg.total_us = entry.total_us;
+  return msg;
+}
+bool APIConnection::send_runtime_stats(const runtime_stats::RuntimeStatsReport &report) {
+  if (!this->runtime_stats_subscription_)
+    return false;
+
+  RuntimeStatsResponse msg;
+  msg.period_ms = report.period_ms;
+  msg.components.reserve(report.components.size());
+  for (auto &entry : report.components)
+    msg.components.push_back(make_runtime_stats_entry(entry));
+  msg.scheduler_items.reserve(report.scheduler_items.size());
+  for (auto &entry : report.scheduler_items)
+    msg.scheduler_items.push_back(make_runtime_stats_entry(entry));
+  return this->send_runtime_stats_response(msg);
+}
+#endif
+
 HelloResponse APIConnection::hello(const HelloRequest &msg) {
   this->client_info_ = msg.client_info + " (" + this->client_->remoteIP().toString().c_str();
   this->client_info_ += ")";
@@ -645,6 +729,15 @@ void APIConnection::on_home_assistant_state_response(const HomeAssistantStateRes
     if (it.entity_id == msg.entity_id)
       it.callback(msg.state);
 }
+#ifdef USE_LOGGER
+void APIConnection::set_log_level(const SetLogLevelRequest &msg) {
+  if (logger::global_logger == nullptr)
+    return;
+  ESP_LOGD(TAG, "%s sets log level of '%s' to %s", this->client_info_.c_str(), msg.tag.c_str(),
+           proto_enum_to_string<enums::LogLevel>(msg.level));
+  logger::global_logger->set_log_level(msg.tag, static_cast<int>(msg.level));
+}
+#endif
 void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
   bool found = false;
   for (auto *service : this->parent_->get_user_services()) {
@@ -670,31 +763,125 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
   if (this->remove_)
     return false;
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(buffer.get_buffer()->size()).encode(header);
-  ProtoVarInt(message_type).encode(header);
+  std::vector<uint8_t> *raw = buffer.get_buffer();
+  const uint32_t msg_size = raw->size() - FRAME_HEADER_PADDING;
+  const ProtoVarInt size_varint(msg_size);
+  const ProtoVarInt type_varint(message_type);
+  const size_t header_size = 1 + size_varint.encoded_size() + type_varint.encoded_size();
+  if (header_size > FRAME_HEADER_PADDING) {
+    ESP_LOGE(TAG, "Message of type %u with %u bytes is too large", message_type, msg_size);
+    return false;
+  }
 
-  size_t needed_space = buffer.get_buffer()->size() + header.size();
+  // write the header right before the body, so the frame is one contiguous block
+  uint8_t *frame = raw->data() + FRAME_HEADER_PADDING - header_size;
+  frame[0] = 0x00;
+  size_varint.encode(frame + 1);
+  type_varint.encode(frame + 1 + size_varint.encoded_size());
+  const size_t needed_space = header_size + msg_size;
 
   if (needed_space > this->client_->space()) {
+    // push out what's queued first, maybe that frees up enough space
+    this->flush_batch_();
     delay(0);
     if (needed_space > this->client_->space()) {
       // SubscribeLogsResponse
       if (message_type != 29) {
         ESP_LOGV(TAG, "Cannot send message because of TCP buffer space");
       }
+      this->batch_send_failed_ = true;
       delay(0);
       return false;
     }
   }
 
-  this->client_->add(reinterpret_cast<char *>(header.data()), header.size(),
-                     ASYNC_WRITE_FLAG_COPY | ASYNC_WRITE_FLAG_MORE);
-  this->client_->add(reinterpret_cast<char *>(buffer.get_buffer()->data()), buffer.get_buffer()->size(),
-                     ASYNC_WRITE_FLAG_COPY);
-  bool ret = this->client_->send();
-  return ret;
+  if (this->batch_) {
+    this->client_->add(reinterpret_cast<char *>(frame), needed_space, ASYNC_WRITE_FLAG_COPY | ASYNC_WRITE_FLAG_MORE);
+    this->batch_pending_ = true;
+    return true;
+  }
+  this->client_->add(reinterpret_cast<char *>(frame), needed_space, ASYNC_WRITE_FLAG_COPY);
+  return this->client_->send();
+}
+bool APIConnection::track_state_(Nameable *entity, PendingStateType type, bool sent) {
+  auto it = std::find_if(this->pending_states_.begin(), this->pending_states_.end(),
+                         [entity](const PendingState &pending) { return pending.entity == entity; });
+  if (sent) {
+    if (it != this->pending_states_.end())
+      this->pending_states_.erase(it);
+  } else if (it == this->pending_states_.end()) {
+    // only the entity is remembered, the resend picks up whatever state is current by then
+    this->pending_states_.push_back(PendingState{entity, type});
+  }
+  return sent;
+}
+bool APIConnection::send_pending_state_(const PendingState &pending) {
+  switch (pending.type) {
+#ifdef USE_BINARY_SENSOR
+    case PendingStateType::BINARY_SENSOR: {
+      auto *obj = static_cast<binary_sensor::BinarySensor *>(pending.entity);
+      return this->send_binary_sensor_state(obj, obj->state);
+    }
+#endif
+#ifdef USE_COVER
+    case PendingStateType::COVER:
+      return this->send_cover_state(static_cast<cover::Cover *>(pending.entity));
+#endif
+#ifdef USE_FAN
+    case PendingStateType::FAN:
+      return this->send_fan_state(static_cast<fan::FanState *>(pending.entity));
+#endif
+#ifdef USE_LIGHT
+    case PendingStateType::LIGHT:
+      return this->send_light_state(static_cast<light::LightState *>(pending.entity));
+#endif
+#ifdef USE_SENSOR
+    case PendingStateType::SENSOR: {
+      auto *obj = static_cast<sensor::Sensor *>(pending.entity);
+      return this->send_sensor_state(obj, obj->state);
+    }
+#endif
+#ifdef USE_SWITCH
+    case PendingStateType::SWITCH: {
+      auto *obj = static_cast<switch_::Switch *>(pending.entity);
+      return this->send_switch_state(obj, obj->state);
+    }
+#endif
+#ifdef USE_TEXT_SENSOR
+    case PendingStateType::TEXT_SENSOR: {
+      auto *obj = static_cast<text_sensor::TextSensor *>(pending.entity);
+      return this->send_text_sensor_state(obj, obj->state);
+    }
+#endif
+#ifdef USE_CLIMATE
+    case PendingStateType::CLIMATE:
+      return this->send_climate_state(static_cast<climate::Climate *>(pending.entity));
+#endif
+    default:
+      return false;
+  }
+}
+void APIConnection::flush_pending_states_() {
+  if (!this->state_subscription_)
+    return;
+  while (!this->pending_states_.empty() && !this->batch_send_failed_) {
+    // a successful send removes the entry in track_state_()
+    if (this->send_pending_state_(this->pending_states_.front()))
+      continue;
+    // out of TCP buffer space, try again in the next loop()
+    if (this->batch_send_failed_)
+      break;
+    // any other failure wouldn't go away by retrying and would hold back all entries behind it
+    ESP_LOGV(TAG, "Dropping pending state that can't be sent");
+    this->pending_states_.erase(this->pending_states_.begin());
+  }
+}
+void APIConnection::flush_batch_() {
+  if (!this->batch_pending_)
+    return;
+  this->batch_pending_ = false;
+  if (!this->remove_)
+    this->client_->send();
 }
 void APIConnection::on_unauthenticated_access() {
   ESP_LOGD(TAG, "'%s' tried to access without authentication.", this->client_info_.c_str());
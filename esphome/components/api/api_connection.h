@@ -5,6 +5,11 @@
 #include "api_pb2.h"
 #include "api_pb2_service.h"
 #include "api_server.h"
+#include "api_recv_buffer.h"
+
+#ifdef USE_RUNTIME_STATS
+#include "esphome/components/runtime_stats/runtime_stats.h"
+#endif
 
 namespace esphome {
 namespace api {
@@ -16,6 +21,8 @@ class APIConnection : public APIServerConnection {
 
   void disconnect_client();
   void loop();
+  /// Whether loop() has nothing to send or parse until new data arrives.
+  bool is_idle() const;
 
   bool send_list_info_done() {
     ListEntitiesDoneResponse resp;
@@ -64,6 +71,12 @@ class APIConnection : public APIServerConnection {
   void climate_command(const ClimateCommandRequest &msg) override;
 #endif
   bool send_log_message(int level, const char *tag, const char *line);
+#ifdef USE_RUNTIME_STATS
+  bool send_runtime_stats(const runtime_stats::RuntimeStatsReport &report);
+  void subscribe_runtime_stats(const SubscribeRuntimeStatsRequest &msg) override {
+    this->runtime_stats_subscription_ = true;
+  }
+#endif
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
     if (!this->service_call_subscription_)
       return;
@@ -108,6 +121,9 @@ class APIConnection : public APIServerConnection {
     if (msg.dump_config)
       App.schedule_dump_config();
   }
+#ifdef USE_LOGGER
+  void set_log_level(const SetLogLevelRequest &msg) override;
+#endif
   void subscribe_homeassistant_services(const SubscribeHomeassistantServicesRequest &msg) override {
     this->service_call_subscription_ = true;
   }
@@ -125,7 +141,8 @@ class APIConnection : public APIServerConnection {
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
   ProtoWriteBuffer create_buffer() override {
-    this->send_buffer_.clear();
+    // reserve space for the frame header, send_buffer() fills it in place
+    this->send_buffer_.resize(FRAME_HEADER_PADDING);
     return {&this->send_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
@@ -138,6 +155,32 @@ class APIConnection : public APIServerConnection {
   void on_timeout_(uint32_t time);
   void on_data_(uint8_t *buf, size_t len);
   void parse_recv_buffer_();
+  /// Send everything that was queued while batching.
+  void flush_batch_();
+
+  enum class PendingStateType : uint8_t {
+    BINARY_SENSOR,
+    COVER,
+    FAN,
+    LIGHT,
+    SENSOR,
+    SWITCH,
+    TEXT_SENSOR,
+    CLIMATE,
+  };
+  struct PendingState {
+    Nameable *entity;
+    PendingStateType type;
+  };
+  /// Record whether the state of entity could be sent, entities that didn't fit are resent from loop().
+  bool track_state_(Nameable *entity, PendingStateType type, bool sent);
+  bool send_pending_state_(const PendingState &pending);
+  /// Resend the latest state of entities that didn't fit into the TCP buffer, oldest first. Stops when the buffer is
+  /// full again, entries that fail for any other reason are dropped.
+  void flush_pending_states_();
+
+  /// Preamble, up to 3 bytes message size (2MiB) and 2 bytes message type.
+  static const size_t FRAME_HEADER_PADDING = 6;
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -148,7 +191,12 @@ class APIConnection : public APIServerConnection {
   bool remove_{false};
 
   std::vector<uint8_t> send_buffer_;
-  std::vector<uint8_t> recv_buffer_;
+  /// While batching, messages are only queued on the socket and sent together in flush_batch_().
+  bool batch_{false};
+  bool batch_pending_{false};
+  bool batch_send_failed_{false};
+  APIRecvBuffer recv_buffer_;
+  volatile bool recv_overflow_{false};
 
   std::string client_info_;
 #ifdef USE_ESP32_CAMERA
@@ -156,10 +204,15 @@ class APIConnection : public APIServerConnection {
 #endif
 
   bool state_subscription_{false};
+  /// At most one entry per entity, so intermediate states of busy entities collapse into the latest one.
+  std::vector<PendingState> pending_states_;
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
   uint32_t last_traffic_;
   bool sent_ping_{false};
   bool service_call_subscription_{false};
+#ifdef USE_RUNTIME_STATS
+  bool runtime_stats_subscription_{false};
+#endif
   bool current_nodelay_{false};
   bool next_close_{false};
   AsyncClient *client_;
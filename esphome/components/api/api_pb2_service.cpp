@@ -184,6 +184,16 @@ bool APIServerConnectionBase::send_climate_state_response(const ClimateStateResp
 #endif
 #ifdef USE_CLIMATE
 #endif
+#ifdef USE_RUNTIME_STATS
+#endif
+#ifdef USE_RUNTIME_STATS
+bool APIServerConnectionBase::send_runtime_stats_response(const RuntimeStatsResponse &msg) {
+  ESP_LOGVV(TAG, "send_runtime_stats_response: %s", msg.dump().c_str());
+  return this->send_message_<RuntimeStatsResponse>(msg, 50);
+}
+#endif
+#ifdef USE_LOGGER
+#endif
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -349,6 +359,24 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       msg.decode(msg_data, msg_size);
       ESP_LOGVV(TAG, "on_climate_command_request: %s", msg.dump().c_str());
       this->on_climate_command_request(msg);
+#endif
+      break;
+    }
+    case 49: {
+#ifdef USE_RUNTIME_STATS
+      SubscribeRuntimeStatsRequest msg;
+      msg.decode(msg_data, msg_size);
+      ESP_LOGVV(TAG, "on_subscribe_runtime_stats_request: %s", msg.dump().c_str());
+      this->on_subscribe_runtime_stats_request(msg);
+#endif
+      break;
+    }
+    case 51: {
+#ifdef USE_LOGGER
+      SetLogLevelRequest msg;
+      msg.decode(msg_data, msg_size);
+      ESP_LOGVV(TAG, "on_set_log_level_request: %s", msg.dump().c_str());
+      this->on_set_log_level_request(msg);
 #endif
       break;
     }
@@ -547,6 +575,32 @@ void APIServerConnection::on_climate_command_request(const ClimateCommandRequest
   this->climate_command(msg);
 }
 #endif
+#ifdef USE_RUNTIME_STATS
+void APIServerConnection::on_subscribe_runtime_stats_request(const SubscribeRuntimeStatsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->subscribe_runtime_stats(msg);
+}
+#endif
+#ifdef USE_LOGGER
+void APIServerConnection::on_set_log_level_request(const SetLogLevelRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->set_log_level(msg);
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
@@ -111,6 +111,15 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_CLIMATE
   virtual void on_climate_command_request(const ClimateCommandRequest &value){};
+#endif
+#ifdef USE_RUNTIME_STATS
+  virtual void on_subscribe_runtime_stats_request(const SubscribeRuntimeStatsRequest &value){};
+#endif
+#ifdef USE_RUNTIME_STATS
+  bool send_runtime_stats_response(const RuntimeStatsResponse &msg);
+#endif
+#ifdef USE_LOGGER
+  virtual void on_set_log_level_request(const SetLogLevelRequest &value){};
 #endif
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
@@ -147,6 +156,12 @@ class APIServerConnection : public APIServerConnectionBase {
 #endif
 #ifdef USE_CLIMATE
   virtual void climate_command(const ClimateCommandRequest &msg) = 0;
+#endif
+#ifdef USE_RUNTIME_STATS
+  virtual void subscribe_runtime_stats(const SubscribeRuntimeStatsRequest &msg) = 0;
+#endif
+#ifdef USE_LOGGER
+  virtual void set_log_level(const SetLogLevelRequest &msg) = 0;
 #endif
  protected:
   void on_hello_request(const HelloRequest &msg) override;
@@ -179,6 +194,12 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_CLIMATE
   void on_climate_command_request(const ClimateCommandRequest &msg) override;
 #endif
+#ifdef USE_RUNTIME_STATS
+  void on_subscribe_runtime_stats_request(const SubscribeRuntimeStatsRequest &msg) override;
+#endif
+#ifdef USE_LOGGER
+  void on_set_log_level_request(const SetLogLevelRequest &msg) override;
+#endif
 };
 
 }  // namespace api
@@ -0,0 +1,139 @@
+#include "api_recv_buffer.h"
+#include "proto.h"
+
+namespace esphome {
+namespace api {
+
+/// Preamble plus two 32-bit varints.
+static const size_t MAX_HEADER_SIZE = 11;
+
+void APIRecvBuffer::init(size_t capacity) {
+  this->capacity_ = capacity;
+  this->ring_size_ = capacity + 1;
+  this->buffer_.reset(new uint8_t[this->ring_size_]);
+  this->head_ = 0;
+  this->tail_ = 0;
+  this->frame_len_ = 0;
+  this->released_ = 0;
+  this->large_frame_ = false;
+}
+size_t APIRecvBuffer::size() const {
+  const size_t head = this->head_;
+  const size_t tail = this->tail_;
+  return head >= tail ? head - tail : this->ring_size_ - tail + head;
+}
+bool APIRecvBuffer::write(const uint8_t *data, size_t len) {
+  if (len > this->capacity_ - this->size())
+    return false;
+
+  size_t head = this->head_;
+  const size_t first = std::min(len, this->ring_size_ - head);
+  memcpy(&this->buffer_[head], data, first);
+  memcpy(&this->buffer_[0], data + first, len - first);
+  head += len;
+  if (head >= this->ring_size_)
+    head -= this->ring_size_;
+  // publish the data only after it has been copied
+  this->head_ = head;
+  return true;
+}
+void APIRecvBuffer::peek_(size_t offset, uint8_t *out, size_t len) const {
+  size_t pos = this->tail_ + offset;
+  if (pos >= this->ring_size_)
+    pos -= this->ring_size_;
+  const size_t first = std::min(len, this->ring_size_ - pos);
+  memcpy(out, &this->buffer_[pos], first);
+  memcpy(out + first, &this->buffer_[0], len - first);
+}
+void APIRecvBuffer::advance_tail_(size_t len) {
+  size_t tail = this->tail_ + len;
+  if (tail >= this->ring_size_)
+    tail -= this->ring_size_;
+  this->tail_ = tail;
+  this->released_ += len;
+}
+APIRecvBuffer::FrameStatus APIRecvBuffer::continue_large_frame_(uint32_t *msg_type, uint8_t **msg_data,
+                                                                uint32_t *msg_size) {
+  const size_t received = this->scratch_.size();
+  const size_t len = std::min(this->size(), this->large_frame_size_ - received);
+  this->scratch_.resize(received + len);
+  this->peek_(0, this->scratch_.data() + received, len);
+  this->advance_tail_(len);
+  if (this->scratch_.size() < this->large_frame_size_)
+    return FrameStatus::INCOMPLETE;
+
+  this->large_frame_ = false;
+  *msg_type = this->large_frame_type_;
+  *msg_data = this->scratch_.data();
+  *msg_size = this->large_frame_size_;
+  // already released from the ring
+  this->frame_len_ = 0;
+  return FrameStatus::READY;
+}
+APIRecvBuffer::FrameStatus APIRecvBuffer::next_frame(uint32_t *msg_type, uint8_t **msg_data, uint32_t *msg_size) {
+  if (this->large_frame_)
+    return this->continue_large_frame_(msg_type, msg_data, msg_size);
+
+  const size_t available = this->size();
+  if (available == 0)
+    return FrameStatus::INCOMPLETE;
+
+  uint8_t header[MAX_HEADER_SIZE];
+  const size_t header_len = std::min(available, MAX_HEADER_SIZE);
+  this->peek_(0, header, header_len);
+  if (header[0] != 0x00)
+    return FrameStatus::BAD_PREAMBLE;
+
+  uint32_t i = 1;
+  uint32_t consumed;
+  auto msg_size_varint = ProtoVarInt::parse(&header[i], header_len - i, &consumed);
+  if (!msg_size_varint.has_value())
+    return header_len == MAX_HEADER_SIZE ? FrameStatus::BAD_HEADER : FrameStatus::INCOMPLETE;
+  i += consumed;
+  auto msg_type_varint = ProtoVarInt::parse(&header[i], header_len - i, &consumed);
+  if (!msg_type_varint.has_value())
+    return header_len == MAX_HEADER_SIZE ? FrameStatus::BAD_HEADER : FrameStatus::INCOMPLETE;
+  i += consumed;
+
+  const uint32_t body_size = msg_size_varint->as_uint32();
+  if (body_size > this->capacity_ - i) {
+    // the frame can never be in the ring at once, collect it while it arrives
+    this->large_frame_ = true;
+    this->large_frame_type_ = msg_type_varint->as_uint32();
+    this->large_frame_size_ = body_size;
+    this->scratch_.clear();
+    this->advance_tail_(i);
+    return this->continue_large_frame_(msg_type, msg_data, msg_size);
+  }
+  if (available - i < body_size)
+    // message body not fully received
+    return FrameStatus::INCOMPLETE;
+
+  size_t body_pos = this->tail_ + i;
+  if (body_pos >= this->ring_size_)
+    body_pos -= this->ring_size_;
+  if (body_pos + body_size <= this->ring_size_) {
+    // common case, decode in place
+    *msg_data = &this->buffer_[body_pos];
+  } else {
+    this->scratch_.resize(body_size);
+    this->peek_(i, this->scratch_.data(), body_size);
+    *msg_data = this->scratch_.data();
+  }
+  *msg_type = msg_type_varint->as_uint32();
+  *msg_size = body_size;
+  this->frame_len_ = i + body_size;
+  return FrameStatus::READY;
+}
+void APIRecvBuffer::consume_frame() {
+  this->advance_tail_(this->frame_len_);
+  this->frame_len_ = 0;
+}
+size_t APIRecvBuffer::take_released() {
+  const size_t released = this->released_;
+  this->released_ = 0;
+  return released;
+}
+
+}  // namespace api
+}  // namespace esphome
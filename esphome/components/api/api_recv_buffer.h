@@ -0,0 +1,81 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace api {
+
+/** Fixed-capacity ring buffer for the receive side of an API connection.
+ *
+ * Data is written by the TCP callback (producer) and frames are decoded by the main loop (consumer). Each side
+ * only moves its own index, so no locking is needed. Frame bodies are decoded in place, only bodies that wrap
+ * around the end of the ring are copied to a scratch buffer first. Frames larger than the ring are collected in
+ * the scratch buffer while they arrive, freeing the ring for the rest of the frame.
+ */
+class APIRecvBuffer {
+ public:
+  enum class FrameStatus {
+    /// Not enough data for a complete frame yet.
+    INCOMPLETE,
+    /// A frame was decoded, release it with consume_frame() after handling it.
+    READY,
+    /// The frame does not start with the 0x00 preamble.
+    BAD_PREAMBLE,
+    /// The message size or type is not a valid varint.
+    BAD_HEADER,
+  };
+
+  /// Allocate the ring, capacity is the number of bytes that can be buffered.
+  void init(size_t capacity);
+
+  /// Append data (producer side), returns false without writing anything if it doesn't fit.
+  bool write(const uint8_t *data, size_t len);
+
+  /** Decode the header of the next frame (consumer side).
+   *
+   * @param msg_type Set to the message type if the frame is ready.
+   * @param msg_data Set to the contiguous message body if the frame is ready, valid until consume_frame().
+   * @param msg_size Set to the size of the message body if the frame is ready.
+   */
+  FrameStatus next_frame(uint32_t *msg_type, uint8_t **msg_data, uint32_t *msg_size);
+
+  /// Release the frame returned by the last next_frame() call.
+  void consume_frame();
+  /// Number of bytes freed since the last call, these can be acknowledged to the sender.
+  size_t take_released();
+
+  size_t size() const;
+  size_t capacity() const { return this->capacity_; }
+  bool empty() const { return this->head_ == this->tail_; }
+
+ protected:
+  /// Copy len bytes starting offset bytes after the tail to out, handling wrap-around.
+  void peek_(size_t offset, uint8_t *out, size_t len) const;
+  /// Free len bytes at the tail.
+  void advance_tail_(size_t len);
+  /// Move the available part of a frame that is larger than the ring to the scratch buffer.
+  FrameStatus continue_large_frame_(uint32_t *msg_type, uint8_t **msg_data, uint32_t *msg_size);
+
+  std::unique_ptr<uint8_t[]> buffer_;
+  /// Bodies that wrap around the end of the ring are linearized here.
+  std::vector<uint8_t> scratch_;
+  /// Size of the ring, one slot is kept free to distinguish full from empty.
+  size_t ring_size_{0};
+  size_t capacity_{0};
+  /// Write index, only modified by the producer.
+  volatile size_t head_{0};
+  /// Read index, only modified by the consumer.
+  volatile size_t tail_{0};
+  /// Total length of the frame returned by next_frame(), 0 if none.
+  size_t frame_len_{0};
+  size_t released_{0};
+  /// Whether a frame larger than the ring is being collected in scratch_.
+  bool large_frame_{false};
+  uint32_t large_frame_type_{0};
+  uint32_t large_frame_size_{0};
+};
+
+}  // namespace api
+}  // namespace esphome
@@ -10,6 +10,10 @@
 #include "esphome/components/logger/logger.h"
 #endif
 
+#ifdef USE_RUNTIME_STATS
+#include "esphome/components/runtime_stats/runtime_stats.h"
+#endif
+
 #include <algorithm>
 
 namespace esphome {
@@ -33,6 +37,8 @@ void APIServer::setup() {
         // ESP_LOGD(TAG, "New client connected from %s", client->remoteIP().toString().c_str());
         auto *a_this = (APIServer *) s;
         a_this->clients_.push_back(new APIConnection(client, a_this));
+        // the server may have declared itself idle, start the handshake right away
+        App.wake_loop_any_context();
       },
       this);
 #ifdef USE_LOGGER
@@ -57,6 +63,17 @@ void APIServer::setup() {
     });
   }
 #endif
+
+#ifdef USE_RUNTIME_STATS
+  if (runtime_stats::global_runtime_stats != nullptr) {
+    runtime_stats::global_runtime_stats->add_on_report_callback(
+        [this](const runtime_stats::RuntimeStatsReport &report) {
+          for (auto *c : this->clients_)
+            if (!c->remove_)
+              c->send_runtime_stats(report);
+        });
+  }
+#endif
 }
 void APIServer::loop() {
   // Partition clients into remove and active
@@ -73,9 +90,13 @@ void APIServer::loop() {
   // resize vector
   this->clients_.erase(new_end, this->clients_.end());
 
+  bool idle = true;
   for (auto *client : this->clients_) {
     client->loop();
+    idle = idle && client->is_idle();
   }
+  // incoming data wakes the main loop, the keepalive only needs checking about once per second
+  this->set_loop_idle(idle);
 
   if (this->reboot_timeout_ != 0) {
     const uint32_t now = millis();
@@ -94,6 +115,7 @@ void APIServer::loop() {
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network_get_address().c_str(), this->port_);
+  ESP_LOGCONFIG(TAG, "  Receive Buffer: %u bytes", this->recv_buffer_size_);
 }
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 bool APIServer::check_password(const std::string &password) const {
@@ -36,6 +36,9 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /// Set the receive buffer capacity of each client connection, should cover the TCP receive window.
+  void set_recv_buffer_size(uint32_t recv_buffer_size) { this->recv_buffer_size_ = recv_buffer_size; }
+  uint32_t get_recv_buffer_size() const { return this->recv_buffer_size_; }
   void handle_disconnect(APIConnection *conn);
 #ifdef USE_BINARY_SENSOR
   void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
@@ -82,6 +85,7 @@ class APIServer : public Component, public Controller {
   AsyncServer server_{0};
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  uint32_t recv_buffer_size_{5840};
   uint32_t last_connected_{0};
   std::vector<APIConnection *> clients_;
   std::string password_;
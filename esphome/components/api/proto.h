@@ -62,8 +62,27 @@ class ProtoVarInt {
     else
       return static_cast<int64_t>(this->value_ >> 1);
   }
+  /// Number of bytes encode() writes.
+  uint8_t encoded_size() const {
+    uint64_t val = this->value_;
+    uint8_t size = 1;
+    while (val > 0x7F) {
+      val >>= 7;
+      size++;
+    }
+    return size;
+  }
+  /// Encode into a raw buffer with at least encoded_size() bytes of space.
+  void encode(uint8_t *out) const {
+    uint64_t val = this->value_;
+    while (val > 0x7F) {
+      *out++ = (val & 0x7F) | 0x80;
+      val >>= 7;
+    }
+    *out = val;
+  }
   void encode(std::vector<uint8_t> &out) {
-    uint32_t val = this->value_;
+    uint64_t val = this->value_;
     if (val <= 0x7F) {
       out.push_back(val);
       return;
@@ -151,11 +170,10 @@ class ProtoWriteBuffer {
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
     auto *data = reinterpret_cast<const uint8_t *>(string);
-    for (size_t i = 0; i < len; i++)
-      this->write(data[i]);
+    this->buffer_->insert(this->buffer_->end(), data, data + len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
-    this->encode_string(field_id, value.data(), value.size());
+    this->encode_string(field_id, value.data(), value.size(), force);
   }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
@@ -200,7 +218,7 @@ class ProtoWriteBuffer {
       uint32_t raw;
     } val{};
     val.value = value;
-    this->encode_fixed32(field_id, val.raw);
+    this->encode_fixed32(field_id, val.raw, true);
   }
   void encode_int32(uint32_t field_id, int32_t value, bool force = false) {
     if (value < 0) {
@@ -223,25 +241,93 @@ class ProtoWriteBuffer {
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // the nested size is known up front, so the length prefix is written in place
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
+  /// Reserve space for `additional` more bytes so encoding does not reallocate.
+  void reserve(size_t additional) { this->buffer_->reserve(this->buffer_->size() + additional); }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
  protected:
   std::vector<uint8_t> *buffer_;
 };
 
+/// Encoded sizes of fields, following the same rules for skipping default values as ProtoWriteBuffer.
+class ProtoSize {
+ public:
+  static uint32_t varint(uint64_t value) { return ProtoVarInt(value).encoded_size(); }
+  static uint32_t field(uint32_t field_id, uint32_t type) { return varint((field_id << 3) | (type & 0b111)); }
+
+  static void add_string_field(uint32_t &total_size, uint32_t field_id, const std::string &value, bool force = false) {
+    add_length_field(total_size, field_id, value.size(), force);
+  }
+  static void add_length_field(uint32_t &total_size, uint32_t field_id, size_t len, bool force = false) {
+    if (len == 0 && !force)
+      return;
+    total_size += field(field_id, 2) + varint(len) + len;
+  }
+  static void add_uint32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_uint64_field(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_bool_field(uint32_t &total_size, uint32_t field_id, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field(field_id, 0) + 1;
+  }
+  static void add_fixed32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  template<typename T> static void add_enum_field(uint32_t &total_size, uint32_t field_id, T value, bool force = false) {
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_float_field(uint32_t &total_size, uint32_t field_id, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_int32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    if (value < 0) {
+      add_int64_field(total_size, field_id, value, force);
+      return;
+    }
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_int64_field(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id, static_cast<uint64_t>(value), force);
+  }
+  static void add_sint32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    uint32_t uvalue;
+    if (value < 0)
+      uvalue = ~(value << 1);
+    else
+      uvalue = value << 1;
+    add_uint32_field(total_size, field_id, uvalue, force);
+  }
+  template<class C>
+  static void add_message_field(uint32_t &total_size, uint32_t field_id, const C &value, bool force = false) {
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    total_size += field(field_id, 2) + varint(nested_length) + nested_length;
+  }
+};
+
 class ProtoMessage {
  public:
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the number of bytes encode() writes to total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
   std::string dump() const;
   virtual void dump_to(std::string &out) const = 0;
@@ -268,7 +354,10 @@ class ProtoService {
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
     auto buffer = this->create_buffer();
+    buffer.reserve(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -30,6 +30,13 @@ DISPLAY_ROTATIONS = {
     270: display_ns.DISPLAY_ROTATION_270_DEGREES,
 }
 
+DISPLAY_BUFFER_FORMATS = {
+    "RGB332": display_ns.DISPLAY_BUFFER_FORMAT_RGB332,
+    "RGB565": display_ns.DISPLAY_BUFFER_FORMAT_RGB565,
+    "GRAYSCALE4": display_ns.DISPLAY_BUFFER_FORMAT_GRAYSCALE4,
+    "BINARY": display_ns.DISPLAY_BUFFER_FORMAT_BINARY,
+}
+
 
 def validate_rotation(value):
     value = cv.string(value)
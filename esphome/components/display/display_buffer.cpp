@@ -19,6 +19,270 @@ void DisplayBuffer::init_internal_(uint32_t buffer_length) {
   }
   this->clear();
 }
+// More regions than this are sent as their bounding box, the per-region overhead isn't worth it anymore.
+static const size_t MAX_DIRTY_REGIONS = 32;
+
+void DisplayBuffer::init_dirty_tiles_(uint8_t bits_per_pixel, uint16_t tile_width, uint16_t tile_height) {
+  this->dirty_bits_per_pixel_ = bits_per_pixel;
+  this->tile_width_ = tile_width;
+  this->tile_height_ = tile_height;
+  this->tiles_x_ = (this->get_width_internal() + tile_width - 1) / tile_width;
+  this->tiles_y_ = (this->get_height_internal() + tile_height - 1) / tile_height;
+  this->tile_checksums_.reset(new uint32_t[size_t(this->tiles_x_) * this->tiles_y_]);
+  this->dirty_tiles_full_ = true;
+}
+uint32_t HOT DisplayBuffer::checksum_tile_(int x, int y, int width, int height) {
+  const uint32_t row_bytes = (uint32_t(this->get_width_internal()) * this->dirty_bits_per_pixel_ + 7) / 8;
+  const uint32_t begin = uint32_t(x) * this->dirty_bits_per_pixel_ / 8;
+  const uint32_t end = (uint32_t(x + width) * this->dirty_bits_per_pixel_ + 7) / 8;
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (int row = y; row < y + height; row++) {
+    const uint8_t *data = this->buffer_ + row * row_bytes;
+    for (uint32_t i = begin; i < end; i++)
+      hash = (hash ^ data[i]) * 16777619UL;
+  }
+  return hash;
+}
+const std::vector<DisplayRegion> &DisplayBuffer::get_dirty_regions_() {
+  this->dirty_regions_.clear();
+  const int width = this->get_width_internal();
+  const int height = this->get_height_internal();
+  if (this->tile_checksums_ == nullptr) {
+    this->dirty_regions_.push_back(DisplayRegion{0, 0, uint16_t(width), uint16_t(height)});
+    return this->dirty_regions_;
+  }
+
+  uint32_t *checksum = this->tile_checksums_.get();
+  for (uint16_t ty = 0; ty < this->tiles_y_; ty++) {
+    const uint16_t y = ty * this->tile_height_;
+    const uint16_t h = std::min<int>(this->tile_height_, height - y);
+    uint16_t run_start = 0;
+    bool in_run = false;
+    for (uint16_t tx = 0; tx <= this->tiles_x_; tx++) {
+      bool changed = false;
+      if (tx < this->tiles_x_) {
+        const uint16_t x = tx * this->tile_width_;
+        uint32_t sum = this->checksum_tile_(x, y, std::min<int>(this->tile_width_, width - x), h);
+        changed = this->dirty_tiles_full_ || sum != *checksum;
+        *checksum++ = sum;
+      }
+      if (changed && !in_run) {
+        run_start = tx;
+        in_run = true;
+      } else if (!changed && in_run) {
+        in_run = false;
+        const uint16_t x = run_start * this->tile_width_;
+        const uint16_t w = std::min<int>(tx * this->tile_width_, width) - x;
+        // grow a region of the previous tile row with the same columns, otherwise start a new one
+        bool merged = false;
+        for (auto &region : this->dirty_regions_) {
+          if (region.x == x && region.width == w && region.y + region.height == y) {
+            region.height += h;
+            merged = true;
+            break;
+          }
+        }
+        if (!merged)
+          this->dirty_regions_.push_back(DisplayRegion{x, y, w, h});
+      }
+    }
+  }
+  this->dirty_tiles_full_ = false;
+
+  if (this->dirty_regions_.size() > MAX_DIRTY_REGIONS) {
+    DisplayRegion bounds = this->dirty_regions_[0];
+    uint16_t x2 = bounds.x + bounds.width, y2 = bounds.y + bounds.height;
+    for (auto &region : this->dirty_regions_) {
+      bounds.x = std::min(bounds.x, region.x);
+      bounds.y = std::min(bounds.y, region.y);
+      x2 = std::max<uint16_t>(x2, region.x + region.width);
+      y2 = std::max<uint16_t>(y2, region.y + region.height);
+    }
+    bounds.width = x2 - bounds.x;
+    bounds.height = y2 - bounds.y;
+    this->dirty_regions_.clear();
+    this->dirty_regions_.push_back(bounds);
+  }
+  return this->dirty_regions_;
+}
+uint8_t DisplayBuffer::get_framebuffer_bits_per_pixel_(DisplayBufferFormat format) {
+  switch (format) {
+    case DISPLAY_BUFFER_FORMAT_RGB565:
+      return 16;
+    case DISPLAY_BUFFER_FORMAT_GRAYSCALE4:
+      return 4;
+    case DISPLAY_BUFFER_FORMAT_BINARY:
+      return 1;
+    case DISPLAY_BUFFER_FORMAT_RGB332:
+    default:
+      return 8;
+  }
+}
+uint32_t DisplayBuffer::get_framebuffer_stride_() {
+  return (uint32_t(this->get_width_internal()) * get_framebuffer_bits_per_pixel_(this->buffer_format_) + 7) / 8;
+}
+uint32_t DisplayBuffer::get_framebuffer_length_() {
+  return this->get_framebuffer_stride_() * this->get_height_internal();
+}
+void DisplayBuffer::init_framebuffer_(DisplayBufferFormat format) {
+  this->buffer_format_ = format;
+  this->init_internal_(this->get_framebuffer_length_());
+  if (this->buffer_ != nullptr)
+    this->init_dirty_tiles_(get_framebuffer_bits_per_pixel_(format));
+}
+const char *DisplayBuffer::framebuffer_format_str_() {
+  switch (this->buffer_format_) {
+    case DISPLAY_BUFFER_FORMAT_RGB332:
+      return "RGB332";
+    case DISPLAY_BUFFER_FORMAT_RGB565:
+      return "RGB565";
+    case DISPLAY_BUFFER_FORMAT_GRAYSCALE4:
+      return "4 bit grayscale";
+    case DISPLAY_BUFFER_FORMAT_BINARY:
+      return "binary";
+    default:
+      return "Unknown";
+  }
+}
+static inline uint8_t color_to_gray8(Color color) {
+  // Rec. 601 luma, white adds on top
+  const uint16_t luma = (color.r * 77 + color.g * 150 + color.b * 29) >> 8;
+  return std::min<uint16_t>(luma + color.w, 255);
+}
+void HOT DisplayBuffer::framebuffer_draw_pixel_(int x, int y, Color color) {
+  if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
+    return;
+  this->framebuffer_fill_span_(x, y, 1, color);
+}
+void HOT DisplayBuffer::framebuffer_fill_span_(int x, int y, int width, Color color) {
+  uint8_t *row = this->buffer_ + y * this->get_framebuffer_stride_();
+  switch (this->buffer_format_) {
+    case DISPLAY_BUFFER_FORMAT_RGB332:
+      memset(row + x, ColorUtil::color_to_332(color), width);
+      break;
+    case DISPLAY_BUFFER_FORMAT_RGB565: {
+      const uint16_t color565 = ColorUtil::color_to_565(color);
+      uint8_t *dst = row + x * 2;
+      for (int i = 0; i < width; i++) {
+        *dst++ = color565 >> 8;
+        *dst++ = color565;
+      }
+      break;
+    }
+    case DISPLAY_BUFFER_FORMAT_GRAYSCALE4: {
+      // two pixels per byte, the left one in the high nibble
+      const uint8_t gray = color_to_gray8(color) >> 4;
+      int i = x;
+      const int end = x + width;
+      if (i & 1) {
+        row[i / 2] = (row[i / 2] & 0xF0) | gray;
+        i++;
+      }
+      if (end - i >= 2) {
+        memset(row + i / 2, gray * 0x11, (end - i) / 2);
+        i += (end - i) & ~1;
+      }
+      if (i < end)
+        row[i / 2] = (row[i / 2] & 0x0F) | (gray << 4);
+      break;
+    }
+    case DISPLAY_BUFFER_FORMAT_BINARY: {
+      // MSB first, whole bytes in the middle
+      const uint32_t end = x + width;
+      const uint32_t first = x / 8u, last = (end - 1) / 8u;
+      const uint8_t first_mask = 0xFF >> (x & 0x07);
+      const uint8_t last_mask = 0xFF << (7 - ((end - 1) & 0x07));
+      const bool on = color.is_on();
+      if (first == last) {
+        const uint8_t mask = first_mask & last_mask;
+        row[first] = on ? row[first] | mask : row[first] & ~mask;
+        break;
+      }
+      row[first] = on ? row[first] | first_mask : row[first] & ~first_mask;
+      if (last > first + 1)
+        memset(row + first + 1, on ? 0xFF : 0x00, last - first - 1);
+      row[last] = on ? row[last] | last_mask : row[last] & ~last_mask;
+      break;
+    }
+  }
+}
+void HOT DisplayBuffer::framebuffer_blit_row_(int x, int y, int width, const Color *colors) {
+  uint8_t *row = this->buffer_ + y * this->get_framebuffer_stride_();
+  switch (this->buffer_format_) {
+    case DISPLAY_BUFFER_FORMAT_RGB332:
+      for (int i = 0; i < width; i++)
+        row[x + i] = ColorUtil::color_to_332(colors[i]);
+      break;
+    case DISPLAY_BUFFER_FORMAT_RGB565: {
+      uint8_t *dst = row + x * 2;
+      for (int i = 0; i < width; i++) {
+        const uint16_t color565 = ColorUtil::color_to_565(colors[i]);
+        *dst++ = color565 >> 8;
+        *dst++ = color565;
+      }
+      break;
+    }
+    case DISPLAY_BUFFER_FORMAT_GRAYSCALE4:
+      for (int i = 0; i < width; i++) {
+        const int pos = x + i;
+        const uint8_t gray = color_to_gray8(colors[i]) >> 4;
+        if (pos & 1) {
+          row[pos / 2] = (row[pos / 2] & 0xF0) | gray;
+        } else {
+          row[pos / 2] = (row[pos / 2] & 0x0F) | (gray << 4);
+        }
+      }
+      break;
+    case DISPLAY_BUFFER_FORMAT_BINARY:
+      for (int i = 0; i < width; i++) {
+        const int pos = x + i;
+        if (colors[i].is_on()) {
+          row[pos / 8] |= 0x80 >> (pos & 0x07);
+        } else {
+          row[pos / 8] &= ~(0x80 >> (pos & 0x07));
+        }
+      }
+      break;
+  }
+}
+void HOT DisplayBuffer::framebuffer_read_565_(int x, int y, int width, uint8_t *out) {
+  const uint8_t *row = this->buffer_ + y * this->get_framebuffer_stride_();
+  switch (this->buffer_format_) {
+    case DISPLAY_BUFFER_FORMAT_RGB332:
+      for (int i = 0; i < width; i++) {
+        // widen each channel so that full intensity stays full intensity
+        const uint8_t c = row[x + i];
+        const uint16_t red = ((c >> 5) * 31 + 3) / 7;
+        const uint16_t green = (((c >> 2) & 0x07) * 63 + 3) / 7;
+        const uint16_t blue = ((c & 0x03) * 31 + 1) / 3;
+        const uint16_t color565 = (red << 11) | (green << 5) | blue;
+        *out++ = color565 >> 8;
+        *out++ = color565;
+      }
+      break;
+    case DISPLAY_BUFFER_FORMAT_RGB565:
+      memcpy(out, row + x * 2, width * 2);
+      break;
+    case DISPLAY_BUFFER_FORMAT_GRAYSCALE4:
+      for (int i = 0; i < width; i++) {
+        const int pos = x + i;
+        const uint8_t gray = (pos & 1) ? row[pos / 2] & 0x0F : row[pos / 2] >> 4;
+        const uint16_t color565 = (uint16_t(gray * 31 / 15) << 11) | (uint16_t(gray * 63 / 15) << 5) | (gray * 31 / 15);
+        *out++ = color565 >> 8;
+        *out++ = color565;
+      }
+      break;
+    case DISPLAY_BUFFER_FORMAT_BINARY:
+      for (int i = 0; i < width; i++) {
+        const int pos = x + i;
+        const uint8_t value = (row[pos / 8] & (0x80 >> (pos & 0x07))) ? 0xFF : 0x00;
+        *out++ = value;
+        *out++ = value;
+      }
+      break;
+  }
+}
 void DisplayBuffer::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
 void DisplayBuffer::clear() { this->fill(COLOR_OFF); }
 int DisplayBuffer::get_width() {
@@ -44,26 +308,104 @@ int DisplayBuffer::get_height() {
   }
 }
 void DisplayBuffer::set_rotation(DisplayRotation rotation) { this->rotation_ = rotation; }
-void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
+void HOT DisplayBuffer::rotate_point_(int *x, int *y) {
   switch (this->rotation_) {
     case DISPLAY_ROTATION_0_DEGREES:
       break;
     case DISPLAY_ROTATION_90_DEGREES:
-      std::swap(x, y);
-      x = this->get_width_internal() - x - 1;
+      std::swap(*x, *y);
+      *x = this->get_width_internal() - *x - 1;
       break;
     case DISPLAY_ROTATION_180_DEGREES:
-      x = this->get_width_internal() - x - 1;
-      y = this->get_height_internal() - y - 1;
+      *x = this->get_width_internal() - *x - 1;
+      *y = this->get_height_internal() - *y - 1;
       break;
     case DISPLAY_ROTATION_270_DEGREES:
-      std::swap(x, y);
-      y = this->get_height_internal() - y - 1;
+      std::swap(*x, *y);
+      *y = this->get_height_internal() - *y - 1;
       break;
   }
+}
+void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
+  this->rotate_point_(&x, &y);
   this->draw_absolute_pixel_internal(x, y, color);
   App.feed_wdt();
 }
+void HOT DisplayBuffer::fill_span_internal(int x, int y, int width, Color color) {
+  for (int i = x; i < x + width; i++)
+    this->draw_absolute_pixel_internal(i, y, color);
+}
+void HOT DisplayBuffer::blit_row_internal(int x, int y, int width, const Color *colors) {
+  for (int i = 0; i < width; i++)
+    this->draw_absolute_pixel_internal(x + i, y, colors[i]);
+}
+void HOT DisplayBuffer::draw_span_at_(int x, int y, int length, bool horizontal, Color color) {
+  int &start = horizontal ? x : y;
+  const int other = horizontal ? y : x;
+  const int limit = horizontal ? this->get_width() : this->get_height();
+  if (other < 0 || other >= (horizontal ? this->get_height() : this->get_width()))
+    return;
+  if (start < 0) {
+    length += start;
+    start = 0;
+  }
+  length = std::min(length, limit - start);
+  if (length <= 0)
+    return;
+
+  // the run stays axis aligned after rotation, it only changes direction
+  int x2 = horizontal ? x + length - 1 : x;
+  int y2 = horizontal ? y : y + length - 1;
+  this->rotate_point_(&x, &y);
+  this->rotate_point_(&x2, &y2);
+  if (y == y2) {
+    this->fill_span_internal(std::min(x, x2), y, length, color);
+  } else {
+    for (int i = std::min(y, y2); i <= std::max(y, y2); i++)
+      this->draw_absolute_pixel_internal(x, i, color);
+  }
+  App.feed_wdt();
+}
+void HOT DisplayBuffer::draw_row_at_(int x, int y, int width, const Color *colors) {
+  if (y < 0 || y >= this->get_height())
+    return;
+  if (x < 0) {
+    colors -= x;
+    width += x;
+    x = 0;
+  }
+  width = std::min(width, this->get_width() - x);
+  if (width <= 0)
+    return;
+
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      this->blit_row_internal(x, y, width, colors);
+      break;
+    case DISPLAY_ROTATION_180_DEGREES: {
+      // the row runs right to left in the buffer
+      Color reversed[32];
+      for (int i = 0; i < width; i += 32) {
+        const int count = std::min(32, width - i);
+        for (int j = 0; j < count; j++)
+          reversed[j] = colors[i + count - 1 - j];
+        int x1 = x + i + count - 1, y1 = y;
+        this->rotate_point_(&x1, &y1);
+        this->blit_row_internal(x1, y1, count, reversed);
+      }
+      break;
+    }
+    default:
+      // columns in the buffer
+      for (int i = 0; i < width; i++) {
+        int x1 = x + i, y1 = y;
+        this->rotate_point_(&x1, &y1);
+        this->draw_absolute_pixel_internal(x1, y1, colors[i]);
+      }
+      break;
+  }
+  App.feed_wdt();
+}
 void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   const int32_t dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
   const int32_t dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
@@ -85,14 +427,10 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  this->draw_span_at_(x, y, width, true, color);
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  this->draw_span_at_(x, y, height, false, color);
 }
 void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
@@ -101,9 +439,13 @@ void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
 void DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
+  // draw along the rows of the buffer
+  if (this->rotation_ == DISPLAY_ROTATION_90_DEGREES || this->rotation_ == DISPLAY_ROTATION_270_DEGREES) {
+    for (int i = x1; i < x1 + width; i++)
+      this->vertical_line(i, y1, height, color);
+  } else {
+    for (int i = y1; i < y1 + height; i++)
+      this->horizontal_line(x1, i, width, color);
   }
 }
 void HOT DisplayBuffer::circle(int center_x, int center_xy, int radius, Color color) {
@@ -171,9 +513,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
       if (!font->get_glyphs().empty()) {
         uint8_t glyph_width = font->get_glyphs()[0].width_;
-        for (int glyph_x = 0; glyph_x < glyph_width; glyph_x++)
-          for (int glyph_y = 0; glyph_y < height; glyph_y++)
-            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
+        this->filled_rectangle(x_at, y_start, glyph_width, height, color);
         x_at += glyph_width;
       }
 
@@ -182,22 +522,49 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
     }
 
     const Glyph &glyph = font->get_glyphs()[glyph_n];
-    int scan_x1, scan_y1, scan_width, scan_height;
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-    for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
-      for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
-        if (glyph.get_pixel(glyph_x, glyph_y)) {
-          this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        }
-      }
-    }
+    this->draw_glyph_(x_at, y_start, glyph, color);
 
     x_at += glyph.width_ + glyph.offset_x_;
 
     i += match_length;
   }
 }
+void HOT DisplayBuffer::draw_glyph_(int x, int y, const Glyph &glyph, Color color) {
+  const uint8_t *data = glyph.data_;
+  // with the whole glyph on screen and no rotation, the spans can go to the driver without clipping
+  const bool direct = this->rotation_ == DISPLAY_ROTATION_0_DEGREES && x + glyph.scan_x_ >= 0 &&
+                      y + glyph.scan_y_ >= 0 && x + glyph.scan_x_ + glyph.scan_width_ <= this->get_width_internal() &&
+                      y + glyph.scan_y_ + glyph.scan_height_ <= this->get_height_internal();
+  for (int row = y + glyph.scan_y_; row < y + glyph.scan_y_ + glyph.scan_height_; row++) {
+    const uint8_t spans = pgm_read_byte(data++);
+    int at = x + glyph.scan_x_;
+    int run_start = at;
+    int run_length = 0;
+    for (uint8_t i = 0; i < spans; i++) {
+      const uint8_t span = pgm_read_byte(data++);
+      at += span >> 4;
+      if (at != run_start + run_length) {
+        // not a continuation of a split run
+        if (run_length != 0 && direct) {
+          this->fill_span_internal(run_start, row, run_length, color);
+        } else if (run_length != 0) {
+          this->horizontal_line(run_start, row, run_length, color);
+        }
+        run_start = at;
+        run_length = 0;
+      }
+      const uint8_t length = span & 0x0F;
+      run_length += length;
+      at += length;
+    }
+    if (run_length != 0 && direct) {
+      this->fill_span_internal(run_start, row, run_length, color);
+    } else if (run_length != 0) {
+      this->horizontal_line(run_start, row, run_length, color);
+    }
+  }
+  App.feed_wdt();
+}
 void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg) {
   char buffer[256];
   int ret = vsnprintf(buffer, sizeof(buffer), format, arg);
@@ -206,28 +573,28 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
 }
 
 void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
-  switch (image->get_type()) {
-    case IMAGE_TYPE_BINARY:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_pixel(img_x, img_y) ? color_on : color_off);
+  // decode up to 32 pixels of a row at a time and hand them to the driver together
+  const int width = image->get_width();
+  const ImageType type = image->get_type();
+  Color row[32];
+  for (int img_y = 0; img_y < image->get_height(); img_y++) {
+    for (int img_x = 0; img_x < width; img_x += 32) {
+      const int count = std::min(32, width - img_x);
+      for (int i = 0; i < count; i++) {
+        switch (type) {
+          case IMAGE_TYPE_BINARY:
+            row[i] = image->get_pixel(img_x + i, img_y) ? color_on : color_off;
+            break;
+          case IMAGE_TYPE_GRAYSCALE:
+            row[i] = image->get_grayscale_pixel(img_x + i, img_y);
+            break;
+          case IMAGE_TYPE_RGB24:
+            row[i] = image->get_color_pixel(img_x + i, img_y);
+            break;
         }
       }
-      break;
-    case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_grayscale_pixel(img_x, img_y));
-        }
-      }
-      break;
-    case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < image->get_width(); img_x++) {
-        for (int img_y = 0; img_y < image->get_height(); img_y++) {
-          this->draw_pixel_at(x + img_x, y + img_y, image->get_color_pixel(img_x, img_y));
-        }
-      }
-      break;
+      this->draw_row_at_(x + img_x, y + img_y, count, row);
+    }
   }
 }
 
@@ -346,21 +713,41 @@ void DisplayBuffer::strftime(int x, int y, Font *font, const char *format, time:
 #endif
 
 Glyph::Glyph(const char *a_char, const uint8_t *data_start, uint32_t offset, int offset_x, int offset_y, int width,
-             int height)
+             int height, int scan_x, int scan_y, int scan_width, int scan_height)
     : char_(a_char),
       data_(data_start + offset),
       offset_x_(offset_x),
       offset_y_(offset_y),
       width_(width),
-      height_(height) {}
+      height_(height),
+      scan_x_(scan_x),
+      scan_y_(scan_y),
+      scan_width_(scan_width),
+      scan_height_(scan_height) {}
 bool Glyph::get_pixel(int x, int y) const {
-  const int x_data = x - this->offset_x_;
-  const int y_data = y - this->offset_y_;
-  if (x_data < 0 || x_data >= this->width_ || y_data < 0 || y_data >= this->height_)
+  if (x < this->scan_x_ || x >= this->scan_x_ + this->scan_width_ || y < this->scan_y_ ||
+      y >= this->scan_y_ + this->scan_height_)
     return false;
-  const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
-  const uint32_t pos = x_data + y_data * width_8;
-  return pgm_read_byte(this->data_ + (pos / 8u)) & (0x80 >> (pos % 8u));
+  const uint8_t *data = this->data_;
+  for (int row = this->scan_y_;; row++) {
+    const uint8_t spans = pgm_read_byte(data++);
+    if (row < y) {
+      data += spans;
+      continue;
+    }
+    int at = this->scan_x_;
+    for (uint8_t i = 0; i < spans; i++) {
+      const uint8_t span = pgm_read_byte(data++);
+      at += span >> 4;
+      const uint8_t length = span & 0x0F;
+      if (x < at)
+        return false;
+      if (x < at + length)
+        return true;
+      at += length;
+    }
+    return false;
+  }
 }
 const char *Glyph::get_char() const { return this->char_; }
 bool Glyph::compare_to(const char *str) const {
@@ -390,10 +777,10 @@ int Glyph::match_length(const char *str) const {
   return 0;
 }
 void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
-  *x1 = this->offset_x_;
-  *y1 = this->offset_y_;
-  *width = this->width_;
-  *height = this->height_;
+  *x1 = this->scan_x_;
+  *y1 = this->scan_y_;
+  *width = this->scan_width_;
+  *height = this->scan_height_;
 }
 int Font::match_next_glyph(const char *str, int *match_length) {
   int lo = 0;
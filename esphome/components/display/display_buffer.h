@@ -5,6 +5,9 @@
 #include "esphome/core/automation.h"
 #include "display_color_utils.h"
 
+#include <memory>
+#include <vector>
+
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
 #endif
@@ -77,7 +80,24 @@ enum DisplayRotation {
   DISPLAY_ROTATION_270_DEGREES = 270,
 };
 
+/// Pixel formats of frame buffers managed by DisplayBuffer::init_framebuffer_().
+enum DisplayBufferFormat : uint8_t {
+  DISPLAY_BUFFER_FORMAT_RGB332 = 0,
+  DISPLAY_BUFFER_FORMAT_RGB565,
+  DISPLAY_BUFFER_FORMAT_GRAYSCALE4,
+  DISPLAY_BUFFER_FORMAT_BINARY,
+};
+
+/// A rectangle in internal (unrotated) display coordinates.
+struct DisplayRegion {
+  uint16_t x;
+  uint16_t y;
+  uint16_t width;
+  uint16_t height;
+};
+
 class Font;
+class Glyph;
 class Image;
 class DisplayBuffer;
 class DisplayPage;
@@ -303,18 +323,74 @@ class DisplayBuffer {
 
  protected:
   void vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg);
+  void draw_glyph_(int x, int y, const Glyph &glyph, Color color);
 
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /** Set width pixels of row y to color, starting at x. Coordinates are internal (unrotated) and already clipped.
+   *
+   * The default goes through draw_absolute_pixel_internal(), drivers with a frame buffer override this to write the
+   * whole run at once.
+   */
+  virtual void fill_span_internal(int x, int y, int width, Color color);
+  /// Like fill_span_internal(), with a color per pixel.
+  virtual void blit_row_internal(int x, int y, int width, const Color *colors);
+
+  /// Map a point from rotated to internal coordinates.
+  void rotate_point_(int *x, int *y);
+  /// Draw a horizontal or vertical run of pixels in rotated coordinates, clipped to the display.
+  void draw_span_at_(int x, int y, int length, bool horizontal, Color color);
+  /// Draw width pixels with their own colors to the right of (x, y) in rotated coordinates, clipped to the display.
+  void draw_row_at_(int x, int y, int width, const Color *colors);
+
   virtual int get_height_internal() = 0;
 
   virtual int get_width_internal() = 0;
 
   void init_internal_(uint32_t buffer_length);
 
+  /** Track which parts of the buffer changed between flushes, in tiles of the internal frame.
+   *
+   * Drivers call this once the display size is known and use get_dirty_regions_() when flushing. The default
+   * checksum_tile_() assumes a row-major buffer with bits_per_pixel bits per pixel.
+   */
+  void init_dirty_tiles_(uint8_t bits_per_pixel, uint16_t tile_width = 16, uint16_t tile_height = 16);
+  /// Regions that changed since the last call, with adjacent changed tiles merged into rectangles.
+  const std::vector<DisplayRegion> &get_dirty_regions_();
+  /// Make the next get_dirty_regions_() report the whole display, for example after the controller lost its memory.
+  void invalidate_dirty_tiles_() { this->dirty_tiles_full_ = true; }
+  virtual uint32_t checksum_tile_(int x, int y, int width, int height);
+
+  /** Allocate a row-major frame buffer in the given format and track changes in it.
+   *
+   * Drivers using this forward draw_absolute_pixel_internal(), fill_span_internal() and blit_row_internal() to the
+   * framebuffer_*_() helpers. RGB565 rows are stored big endian and can be sent to the panel as they are, other
+   * formats are converted a row at a time with framebuffer_read_565_().
+   */
+  void init_framebuffer_(DisplayBufferFormat format);
+  static uint8_t get_framebuffer_bits_per_pixel_(DisplayBufferFormat format);
+  uint32_t get_framebuffer_stride_();
+  uint32_t get_framebuffer_length_();
+  void framebuffer_draw_pixel_(int x, int y, Color color);
+  void framebuffer_fill_span_(int x, int y, int width, Color color);
+  void framebuffer_blit_row_(int x, int y, int width, const Color *colors);
+  /// Convert width pixels of row y, starting at x, to big endian RGB565.
+  void framebuffer_read_565_(int x, int y, int width, uint8_t *out);
+  const char *framebuffer_format_str_();
+
   void do_update_();
 
   uint8_t *buffer_{nullptr};
+  DisplayBufferFormat buffer_format_{DISPLAY_BUFFER_FORMAT_RGB332};
+  uint8_t dirty_bits_per_pixel_{0};
+  uint16_t tile_width_{0};
+  uint16_t tile_height_{0};
+  uint16_t tiles_x_{0};
+  uint16_t tiles_y_{0};
+  /// Checksum of every tile at the last flush.
+  std::unique_ptr<uint32_t[]> tile_checksums_;
+  std::vector<DisplayRegion> dirty_regions_;
+  bool dirty_tiles_full_{true};
   DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
   optional<display_writer_t> writer_{};
   DisplayPage *page_{nullptr};
@@ -338,11 +414,18 @@ class DisplayPage {
   DisplayPage *next_{nullptr};
 };
 
+/** A glyph of a Font, stored as runs of set pixels.
+ *
+ * The data covers only the bounding box of the set pixels. Every row of the box is a span count followed by one byte
+ * per span: the pixels to skip in the high nibble, the span length in the low nibble. Skip is counted from the end of
+ * the previous span or the left edge of the box.
+ */
 class Glyph {
  public:
   Glyph(const char *a_char, const uint8_t *data_start, uint32_t offset, int offset_x, int offset_y, int width,
-        int height);
+        int height, int scan_x, int scan_y, int scan_width, int scan_height);
 
+  /// Slow, decodes the row. Drawing goes through the spans directly.
   bool get_pixel(int x, int y) const;
 
   const char *get_char() const;
@@ -363,6 +446,10 @@ class Glyph {
   int offset_y_;
   int width_;
   int height_;
+  int scan_x_;
+  int scan_y_;
+  int scan_width_;
+  int scan_height_;
 };
 
 class Font {
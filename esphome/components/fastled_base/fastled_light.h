@@ -227,6 +227,12 @@ class FastLEDLightOutput : public light::AddressableLight {
     return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
             &this->effect_data_[index], &this->correction_};
   }
+  light::ESPPixelSpan get_pixel_span_internal() const override {
+    light::ESPPixelSpan span;
+    span.data = reinterpret_cast<uint8_t *>(this->leds_);
+    span.size = this->num_leds_;
+    return span;
+  }
 
   CLEDController *controller_{nullptr};
   CRGB *leds_{nullptr};
@@ -89,6 +89,51 @@ FONT_SCHEMA = cv.Schema(
 CONFIG_SCHEMA = cv.All(validate_pillow_installed, FONT_SCHEMA)
 
 
+def encode_glyph_spans(pixels, width, height):
+    """Encode a glyph bitmap as runs of set pixels, cropped to its bounding box.
+
+    Returns the bounding box (x, y, width, height) relative to the glyph and the data.
+    Every row of the bounding box is a span count followed by one byte per span, with
+    the pixels to skip in the high nibble and the span length in the low nibble. Skip
+    is counted from the end of the previous span (or the left edge of the box).
+    """
+    rows = [[bool(pixels((x, y))) for x in range(width)] for y in range(height)]
+    set_x = [x for row in rows for x, on in enumerate(row) if on]
+    set_y = [y for y, row in enumerate(rows) if any(row)]
+    if not set_x:
+        return (0, 0, 0, 0), []
+    x1, x2 = min(set_x), max(set_x) + 1
+    y1, y2 = min(set_y), max(set_y) + 1
+
+    data = []
+    for row in rows[y1:y2]:
+        spans = []
+        x = x1
+        last_end = x1
+        while x < x2:
+            if not row[x]:
+                x += 1
+                continue
+            start = x
+            while x < x2 and row[x]:
+                x += 1
+            skip, length = start - last_end, x - start
+            # longer runs are split into several spans
+            while skip > 15:
+                spans.append((15, 0))
+                skip -= 15
+            while length > 15:
+                spans.append((skip, 15))
+                skip, length = 0, length - 15
+            spans.append((skip, length))
+            last_end = x
+        if len(spans) > 255:
+            raise core.EsphomeError("Glyph is too large to be encoded")
+        data.append(len(spans))
+        data += [skip << 4 | length for skip, length in spans]
+    return (x1, y1, x2 - x1, y2 - y1), data
+
+
 def to_code(config):
     from PIL import ImageFont
 
@@ -106,15 +151,20 @@ def to_code(config):
         mask = font.getmask(glyph, mode="1")
         _, (offset_x, offset_y) = font.font.getsize(glyph)
         width, height = mask.size
-        width8 = ((width + 7) // 8) * 8
-        glyph_data = [0 for _ in range(height * width8 // 8)]  # noqa: F812
-        for y in range(height):
-            for x in range(width):
-                if not mask.getpixel((x, y)):
-                    continue
-                pos = x + y * width8
-                glyph_data[pos // 8] |= 0x80 >> (pos % 8)
-        glyph_args[glyph] = (len(data), offset_x, offset_y, width, height)
+        (scan_x, scan_y, scan_width, scan_height), glyph_data = encode_glyph_spans(
+            mask.getpixel, width, height
+        )
+        glyph_args[glyph] = (
+            len(data),
+            offset_x,
+            offset_y,
+            width,
+            height,
+            offset_x + scan_x,
+            offset_y + scan_y,
+            scan_width,
+            scan_height,
+        )
         data += glyph_data
 
     rhs = [HexInt(x) for x in data]
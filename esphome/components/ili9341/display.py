@@ -14,6 +14,7 @@ from esphome.const import (
 DEPENDENCIES = ["spi"]
 
 CONF_LED_PIN = "led_pin"
+CONF_BUFFER_FORMAT = "buffer_format"
 
 ili9341_ns = cg.esphome_ns.namespace("ili9341")
 ili9341 = ili9341_ns.class_(
@@ -39,6 +40,9 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_DC_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_RESET_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_LED_PIN): pins.gpio_output_pin_schema,
+            cv.Optional(CONF_BUFFER_FORMAT, default="RGB332"): cv.enum(
+                display.DISPLAY_BUFFER_FORMATS, upper=True
+            ),
         }
     )
     .extend(cv.polling_component_schema("1s"))
@@ -59,6 +63,7 @@ def to_code(config):
     yield display.register_display(var, config)
     yield spi.register_spi_device(var, config)
     cg.add(var.set_model(config[CONF_MODEL]))
+    cg.add(var.set_buffer_format(config[CONF_BUFFER_FORMAT]))
     dc = yield cg.gpio_pin_expression(config[CONF_DC_PIN])
     cg.add(var.set_dc_pin(dc))
 
@@ -9,7 +9,6 @@ namespace ili9341 {
 static const char *TAG = "ili9341";
 
 void ILI9341Display::setup_pins_() {
-  this->init_internal_(this->get_buffer_length_());
   this->dc_pin_->setup();  // OUTPUT
   this->dc_pin_->digital_write(false);
   if (this->reset_pin_ != nullptr) {
@@ -28,6 +27,11 @@ void ILI9341Display::setup_pins_() {
 void ILI9341Display::dump_config() {
   LOG_DISPLAY("", "ili9341", this);
   ESP_LOGCONFIG(TAG, "  Width: %d, Height: %d,  Rotation: %d", this->width_, this->height_, this->rotation_);
+  ESP_LOGCONFIG(TAG, "  Buffer Format: %s (%u bytes)", this->framebuffer_format_str_(), this->get_framebuffer_length_());
+  if (this->last_frame_time_us_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Last Frame: %.1f ms, %u bytes sent", this->last_frame_time_us_ / 1000.0f,
+                  this->last_frame_bytes_);
+  }
   LOG_PIN("  Reset Pin: ", this->reset_pin_);
   LOG_PIN("  DC Pin: ", this->dc_pin_);
   LOG_PIN("  Busy Pin: ", this->busy_pin_);
@@ -79,96 +83,75 @@ uint8_t ILI9341Display::read_command(uint8_t command_byte, uint8_t index) {
 }
 
 void ILI9341Display::update() {
+  const uint32_t start = micros();
   this->do_update_();
   this->display_();
+  this->last_frame_time_us_ = micros() - start;
+  ESP_LOGVV(TAG, "Frame took %u us, sent %u bytes", this->last_frame_time_us_, this->last_frame_bytes_);
 }
 
 void ILI9341Display::display_() {
-  // we will only update the changed window to the display
-  int w = this->x_high_ - this->x_low_ + 1;
-  int h = this->y_high_ - this->y_low_ + 1;
+  if (this->buffer_ == nullptr)
+    return;
+  // we will only update the changed regions to the display
+  this->last_frame_bytes_ = 0;
+  for (auto &region : this->get_dirty_regions_())
+    this->write_region_(region);
+}
 
-  set_addr_window_(this->x_low_, this->y_low_, w, h);
+void HOT ILI9341Display::write_region_(const display::DisplayRegion &region) {
+  this->set_addr_window_(region.x, region.y, region.width, region.height);
   this->start_data_();
-  uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
-  for (uint16_t row = 0; row < h; row++) {
-    for (uint16_t col = 0; col < w; col++) {
-      uint32_t pos = start_pos + (row * width_) + col;
-
-      uint16_t color = convert_to_16bit_color_(buffer_[pos]);
-      this->write_byte(color >> 8);
-      this->write_byte(color);
+  const uint32_t stride = this->get_framebuffer_stride_();
+  if (this->buffer_format_ == display::DISPLAY_BUFFER_FORMAT_RGB565) {
+    // the buffer already holds what the panel expects, send it in as few bursts as possible
+    if (region.width == this->width_) {
+      this->write_array(this->buffer_ + region.y * stride, region.height * stride);
+    } else {
+      for (uint16_t row = region.y; row < region.y + region.height; row++)
+        this->write_array(this->buffer_ + row * stride + region.x * 2, region.width * 2);
+    }
+  } else {
+    if (this->line_buffer_ == nullptr)
+      this->line_buffer_.reset(new uint8_t[this->get_width_internal() * 2]);
+    uint8_t *line = this->line_buffer_.get();
+    for (uint16_t row = region.y; row < region.y + region.height; row++) {
+      this->framebuffer_read_565_(region.x, row, region.width, line);
+      this->write_array(line, region.width * 2);
     }
   }
   this->end_data_();
-
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
-}
-
-uint16_t ILI9341Display::convert_to_16bit_color_(uint8_t color_8bit) {
-  int r = color_8bit >> 5;
-  int g = (color_8bit >> 2) & 0x07;
-  int b = color_8bit & 0x03;
-  uint16_t color = (r * 0x04) << 11;
-  color |= (g * 0x09) << 5;
-  color |= (b * 0x0A);
-
-  return color;
-}
-
-uint8_t ILI9341Display::convert_to_8bit_color_(uint16_t color_16bit) {
-  // convert 16bit color to 8 bit buffer
-  uint8_t r = color_16bit >> 11;
-  uint8_t g = (color_16bit >> 5) & 0x3F;
-  uint8_t b = color_16bit & 0x1F;
-
-  return ((b / 0x0A) | ((g / 0x09) << 2) | ((r / 0x04) << 5));
-}
-
-void ILI9341Display::fill(Color color) {
-  auto color565 = display::ColorUtil::color_to_565(color);
-  memset(this->buffer_, convert_to_8bit_color_(color565), this->get_buffer_length_());
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  this->last_frame_bytes_ += uint32_t(region.width) * region.height * 2;
 }
 
 void ILI9341Display::fill_internal_(Color color) {
   this->set_addr_window_(0, 0, this->get_width_internal(), this->get_height_internal());
   this->start_data_();
 
+  if (this->line_buffer_ == nullptr)
+    this->line_buffer_.reset(new uint8_t[this->get_width_internal() * 2]);
+  uint8_t *line = this->line_buffer_.get();
   auto color565 = display::ColorUtil::color_to_565(color);
-  for (uint32_t i = 0; i < (this->get_width_internal()) * (this->get_height_internal()); i++) {
-    this->write_byte(color565 >> 8);
-    this->write_byte(color565);
-    buffer_[i] = 0;
+  for (int i = 0; i < this->get_width_internal(); i++) {
+    line[i * 2] = color565 >> 8;
+    line[i * 2 + 1] = color565;
   }
+  for (int row = 0; row < this->get_height_internal(); row++)
+    this->write_array(line, this->get_width_internal() * 2);
   this->end_data_();
 }
 
 void HOT ILI9341Display::draw_absolute_pixel_internal(int x, int y, Color color) {
-  if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
-    return;
-
-  // low and high watermark may speed up drawing from buffer
-  this->x_low_ = (x < this->x_low_) ? x : this->x_low_;
-  this->y_low_ = (y < this->y_low_) ? y : this->y_low_;
-  this->x_high_ = (x > this->x_high_) ? x : this->x_high_;
-  this->y_high_ = (y > this->y_high_) ? y : this->y_high_;
+  this->framebuffer_draw_pixel_(x, y, color);
+}
 
-  uint32_t pos = (y * width_) + x;
-  auto color565 = display::ColorUtil::color_to_565(color);
-  buffer_[pos] = convert_to_8bit_color_(color565);
+void HOT ILI9341Display::fill_span_internal(int x, int y, int width, Color color) {
+  this->framebuffer_fill_span_(x, y, width, color);
 }
 
-// should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
-// values per bit is huge
-uint32_t ILI9341Display::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal(); }
+void HOT ILI9341Display::blit_row_internal(int x, int y, int width, const Color *colors) {
+  this->framebuffer_blit_row_(x, y, width, colors);
+}
 
 void ILI9341Display::start_command_() {
   this->dc_pin_->digital_write(false);
@@ -197,19 +180,15 @@ void ILI9341Display::init_lcd_(const uint8_t *init_cmd) {
 
 void ILI9341Display::set_addr_window_(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h) {
   uint16_t x2 = (x1 + w - 1), y2 = (y1 + h - 1);
+  const uint8_t columns[4] = {uint8_t(x1 >> 8), uint8_t(x1), uint8_t(x2 >> 8), uint8_t(x2)};
+  const uint8_t rows[4] = {uint8_t(y1 >> 8), uint8_t(y1), uint8_t(y2 >> 8), uint8_t(y2)};
   this->command(ILI9341_CASET);  // Column address set
   this->start_data_();
-  this->write_byte(x1 >> 8);
-  this->write_byte(x1);
-  this->write_byte(x2 >> 8);
-  this->write_byte(x2);
+  this->write_array(columns, 4);
   this->end_data_();
   this->command(ILI9341_PASET);  // Row address set
   this->start_data_();
-  this->write_byte(y1 >> 8);
-  this->write_byte(y1);
-  this->write_byte(y2 >> 8);
-  this->write_byte(y2);
+  this->write_array(rows, 4);
   this->end_data_();
   this->command(ILI9341_RAMWR);  // Write to RAM
 }
@@ -24,6 +24,7 @@ class ILI9341Display : public PollingComponent,
   void set_reset_pin(GPIOPin *reset) { this->reset_pin_ = reset; }
   void set_led_pin(GPIOPin *led) { this->led_pin_ = led; }
   void set_model(ILI9341Model model) { this->model_ = model; }
+  void set_buffer_format(display::DisplayBufferFormat format) { this->buffer_format_ = format; }
 
   void command(uint8_t value);
   void data(uint8_t value);
@@ -33,16 +34,17 @@ class ILI9341Display : public PollingComponent,
 
   void update() override;
 
-  void fill(Color color) override;
-
   void dump_config() override;
   void setup() override {
     this->setup_pins_();
     this->initialize();
+    this->init_framebuffer_(this->buffer_format_);
   }
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_row_internal(int x, int y, int width, const Color *colors) override;
   void setup_pins_();
 
   void init_lcd_(const uint8_t *init_cmd);
@@ -51,18 +53,16 @@ class ILI9341Display : public PollingComponent,
   void reset_();
   void fill_internal_(Color color);
   void display_();
-  uint16_t convert_to_16bit_color_(uint8_t color_8bit);
-  uint8_t convert_to_8bit_color_(uint16_t color_16bit);
+  void write_region_(const display::DisplayRegion &region);
 
   ILI9341Model model_;
   int16_t width_{320};   ///< Display width as modified by current rotation
   int16_t height_{240};  ///< Display height as modified by current rotation
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
+  /// One row converted to 16 bit color, allocated when first needed.
+  std::unique_ptr<uint8_t[]> line_buffer_;
+  uint32_t last_frame_time_us_{0};
+  uint32_t last_frame_bytes_{0};
 
-  uint32_t get_buffer_length_();
   int get_width_internal() override;
   int get_height_internal() override;
 
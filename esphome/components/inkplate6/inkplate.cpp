@@ -3,6 +3,8 @@
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 #ifdef ARDUINO_ARCH_ESP32
 
 namespace esphome {
@@ -219,7 +221,13 @@ void Inkplate6::display() {
   if (this->greyscale_) {
     this->display3b_();
   } else {
-    if (this->partial_updating_ && this->partial_update_()) {
+    // buffer_ holds the frame on the panel, partial_buffer_ the new one
+    int first_row, last_row;
+    if (!this->find_changed_rows_(&first_row, &last_row) && !this->block_partial_) {
+      ESP_LOGV(TAG, "Frame unchanged, skipping refresh");
+      return;
+    }
+    if (this->partial_updating_ && this->partial_update_(first_row, last_row)) {
       ESP_LOGV(TAG, "Display finished (partial) (%lums)", millis() - start_time);
       return;
     }
@@ -422,7 +430,19 @@ void Inkplate6::display3b_() {
   eink_off_();
   ESP_LOGV(TAG, "Display3b finished (%lums)", millis() - start_time);
 }
-bool Inkplate6::partial_update_() {
+bool Inkplate6::find_changed_rows_(int *first_row, int *last_row) {
+  const uint32_t row_bytes = this->get_width_internal() / 8;
+  *first_row = this->get_height_internal();
+  *last_row = -1;
+  for (int i = 0, im = this->get_height_internal(); i < im; i++) {
+    if (memcmp(this->buffer_ + i * row_bytes, this->partial_buffer_ + i * row_bytes, row_bytes) != 0) {
+      *first_row = std::min(*first_row, i);
+      *last_row = i;
+    }
+  }
+  return *last_row >= 0;
+}
+bool Inkplate6::partial_update_(int first_row, int last_row) {
   ESP_LOGV(TAG, "Partial update called");
   unsigned long start_time = millis();
   if (this->greyscale_)
@@ -432,20 +452,21 @@ bool Inkplate6::partial_update_() {
 
   this->partial_updates_++;
 
-  uint16_t pos = this->get_buffer_length_() - 1;
   uint32_t send;
   uint8_t data;
   uint8_t diffw, diffb;
-  uint32_t n = (this->get_buffer_length_() * 2) - 1;
 
-  for (int i = 0, im = this->get_height_internal(); i < im; i++) {
-    for (int j = 0, jm = (this->get_width_internal() / 8); j < jm; j++) {
-      diffw = (this->buffer_[pos] ^ this->partial_buffer_[pos]) & ~(this->partial_buffer_[pos]);
-      diffb = (this->buffer_[pos] ^ this->partial_buffer_[pos]) & this->partial_buffer_[pos];
-      pos--;
-      this->partial_buffer_2_[n--] = LUTW[diffw >> 4] & LUTB[diffb >> 4];
-      this->partial_buffer_2_[n--] = LUTW[diffw & 0x0F] & LUTB[diffb & 0x0F];
-    }
+  // rows outside the changed band get "no change" for every pixel, only the band needs the lookup
+  const uint32_t row_bytes = this->get_width_internal() / 8;
+  const uint32_t band_begin = first_row * row_bytes;
+  const uint32_t band_end = (last_row + 1) * row_bytes;
+  memset(this->partial_buffer_2_, 0xFF, band_begin * 2);
+  memset(this->partial_buffer_2_ + band_end * 2, 0xFF, (this->get_buffer_length_() - band_end) * 2);
+  for (uint32_t pos = band_begin, n = band_begin * 2; pos < band_end; pos++) {
+    diffw = (this->buffer_[pos] ^ this->partial_buffer_[pos]) & ~(this->partial_buffer_[pos]);
+    diffb = (this->buffer_[pos] ^ this->partial_buffer_[pos]) & this->partial_buffer_[pos];
+    this->partial_buffer_2_[n++] = LUTW[diffw & 0x0F] & LUTB[diffb & 0x0F];
+    this->partial_buffer_2_[n++] = LUTW[diffw >> 4] & LUTB[diffb >> 4];
   }
   ESP_LOGV(TAG, "Partial update buffer built after (%lums)", millis() - start_time);
 
@@ -478,8 +499,8 @@ bool Inkplate6::partial_update_() {
   vscan_start_();
   eink_off_();
 
-  memcpy(this->buffer_, this->partial_buffer_, this->get_buffer_length_());
-  ESP_LOGV(TAG, "Partial update finished (%lums)", millis() - start_time);
+  memcpy(this->buffer_ + band_begin, this->partial_buffer_ + band_begin, band_end - band_begin);
+  ESP_LOGV(TAG, "Partial update of rows %d-%d finished (%lums)", first_row, last_row, millis() - start_time);
   return true;
 }
 void Inkplate6::vscan_start_() {
@@ -533,6 +554,9 @@ void Inkplate6::clean() {
   ESP_LOGV(TAG, "Clean called");
   unsigned long start_time = millis();
 
+  // the panel no longer shows buffer_, so the next update has to be a full one
+  this->block_partial_ = true;
+
   eink_on_();
   clean_fast_(0, 1);   // White
   clean_fast_(0, 8);   // White to White
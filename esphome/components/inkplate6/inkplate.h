@@ -82,7 +82,9 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
   void display1b_();
   void display3b_();
   void initialize_();
-  bool partial_update_();
+  /// Rows where partial_buffer_ differs from buffer_, returns false if the frames are equal.
+  bool find_changed_rows_(int *first_row, int *last_row);
+  bool partial_update_(int first_row, int last_row);
   void clean_fast_(uint8_t c, uint8_t rep);
 
   void hscan_start_(uint32_t d);
@@ -46,6 +46,22 @@ const char *build_json(const json_build_t &f, size_t *length) {
   *length = bytes_written;
   return global_json_build_buffer;
 }
+static bool write_json_to_global_build_buffer(const json_write_t &f, size_t *length) {
+  JsonWriter writer(global_json_build_buffer, global_json_build_buffer_size);
+  writer.begin_object();
+  f(writer);
+  writer.end_object();
+  *length = writer.length();
+  return writer.finish();
+}
+const char *write_json(const json_write_t &f, size_t *length) {
+  if (!write_json_to_global_build_buffer(f, length)) {
+    // The writer measured the exact size even though the output didn't fit, so one retry is enough.
+    reserve_global_json_build_buffer(*length + 1);
+    write_json_to_global_build_buffer(f, length);
+  }
+  return global_json_build_buffer;
+}
 void parse_json(const std::string &data, const json_parse_t &f) {
   global_json_buffer.clear();
   JsonObject &root = global_json_buffer.parseObject(data);
@@ -63,6 +79,12 @@ std::string build_json(const json_build_t &f) {
   return std::string(c_str, len);
 }
 
+std::string write_json(const json_write_t &f) {
+  size_t len;
+  const char *c_str = write_json(f, &len);
+  return std::string(c_str, len);
+}
+
 VectorJsonBuffer::String::String(VectorJsonBuffer *parent) : parent_(parent), start_(parent->size_) {}
 void VectorJsonBuffer::String::append(char c) const {
   char *last = static_cast<char *>(this->parent_->do_alloc(1));
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/helpers.h"
+#include "json_writer.h"
 #include <ArduinoJson.h>
 
 namespace esphome {
@@ -17,6 +18,18 @@ const char *build_json(const json_build_t &f, size_t *length);
 
 std::string build_json(const json_build_t &f);
 
+/// Callback function typedef for writing JSON objects member by member.
+using json_write_t = std::function<void(JsonWriter &)>;
+
+/** Write a JSON object with the provided json write function, without building a JsonObject first.
+ *
+ * The function is called inside the root object and may be called twice, the second time after the buffer
+ * was grown to the length measured by the first call, so it must write the same output both times.
+ */
+const char *write_json(const json_write_t &f, size_t *length);
+
+std::string write_json(const json_write_t &f);
+
 /// Parse a JSON string and run the provided json parse function if it's valid.
 void parse_json(const std::string &data, const json_parse_t &f);
 
@@ -0,0 +1,159 @@
+#include "json_writer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace json {
+
+JsonWriter::JsonWriter(char *buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {}
+
+void JsonWriter::begin_object() {
+  this->begin_value_();
+  this->push_('{');
+}
+void JsonWriter::begin_object(const char *key) {
+  this->write_key_(key);
+  this->push_('{');
+}
+void JsonWriter::end_object() { this->pop_('}'); }
+void JsonWriter::begin_array(const char *key) {
+  this->write_key_(key);
+  this->push_('[');
+}
+void JsonWriter::end_array() { this->pop_(']'); }
+
+void JsonWriter::add(const char *key, const char *value) {
+  this->write_key_(key);
+  this->write_string_(value, strlen(value));
+}
+void JsonWriter::add(const char *key, const std::string &value) {
+  this->write_key_(key);
+  this->write_string_(value.data(), value.size());
+}
+void JsonWriter::add(const char *key, bool value) {
+  this->write_key_(key);
+  if (value) {
+    this->write_("true", 4);
+  } else {
+    this->write_("false", 5);
+  }
+}
+void JsonWriter::add(const char *key, float value) {
+  this->write_key_(key);
+  // JSON has no representation for NaN or infinity
+  if (std::isnan(value) || std::isinf(value)) {
+    this->write_("null", 4);
+    return;
+  }
+  char buffer[24];
+  int len = snprintf(buffer, sizeof(buffer), "%.7g", value);
+  this->write_(buffer, len);
+}
+void JsonWriter::add(const char *value) {
+  this->begin_value_();
+  this->write_string_(value, strlen(value));
+}
+void JsonWriter::add(const std::string &value) {
+  this->begin_value_();
+  this->write_string_(value.data(), value.size());
+}
+
+size_t JsonWriter::length() const { return this->length_; }
+bool JsonWriter::fits() const { return this->length_ < this->capacity_; }
+bool JsonWriter::finish() {
+  if (!this->fits())
+    return false;
+  this->buffer_[this->length_] = '\0';
+  return true;
+}
+
+void JsonWriter::begin_value_() {
+  if (this->depth_ == 0)
+    return;
+  const uint32_t bit = 1UL << this->depth_;
+  if (this->first_ & bit) {
+    this->first_ &= ~bit;
+  } else {
+    this->write_(',');
+  }
+}
+void JsonWriter::write_key_(const char *key) {
+  this->begin_value_();
+  this->write_string_(key, strlen(key));
+  this->write_(':');
+}
+void JsonWriter::push_(char c) {
+  this->write_(c);
+  this->depth_++;
+  this->first_ |= 1UL << this->depth_;
+}
+void JsonWriter::pop_(char c) {
+  this->depth_--;
+  this->write_(c);
+}
+void JsonWriter::write_(const char *str, size_t len) {
+  if (this->length_ < this->capacity_) {
+    const size_t fit = std::min(len, this->capacity_ - this->length_);
+    memcpy(this->buffer_ + this->length_, str, fit);
+  }
+  this->length_ += len;
+}
+void JsonWriter::write_string_(const char *str, size_t len) {
+  static const char *const HEX_DIGITS = "0123456789abcdef";
+  this->write_('"');
+  size_t start = 0;
+  for (size_t i = 0; i < len; i++) {
+    const uint8_t c = str[i];
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+    // copy the run of characters that need no escaping in one go
+    this->write_(str + start, i - start);
+    start = i + 1;
+    this->write_('\\');
+    switch (c) {
+      case '"':
+      case '\\':
+        this->write_(c);
+        break;
+      case '\n':
+        this->write_('n');
+        break;
+      case '\r':
+        this->write_('r');
+        break;
+      case '\t':
+        this->write_('t');
+        break;
+      default:
+        this->write_("u00", 3);
+        this->write_(HEX_DIGITS[c >> 4]);
+        this->write_(HEX_DIGITS[c & 0x0F]);
+        break;
+    }
+  }
+  this->write_(str + start, len - start);
+  this->write_('"');
+}
+void JsonWriter::write_int_(int32_t value) {
+  if (value < 0) {
+    this->write_('-');
+    this->write_uint_(-static_cast<uint32_t>(value));
+  } else {
+    this->write_uint_(value);
+  }
+}
+void JsonWriter::write_uint_(uint32_t value) {
+  char buffer[10];
+  char *end = buffer + sizeof(buffer);
+  char *begin = end;
+  do {
+    *--begin = '0' + value % 10;
+    value /= 10;
+  } while (value != 0);
+  this->write_(begin, end - begin);
+}
+
+}  // namespace json
+}  // namespace esphome
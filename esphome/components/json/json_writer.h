@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace esphome {
+namespace json {
+
+/** Streaming JSON writer that serializes directly into a character buffer without building a document first.
+ *
+ * Output that doesn't fit into the buffer is dropped, but the length keeps counting, so after a pass
+ * length() is the exact size of the document and the caller can grow the buffer and write it again.
+ * A writer without a buffer only measures. Members are written in the order they're added.
+ */
+class JsonWriter {
+ public:
+  /// Create a writer that only measures the length of the output.
+  JsonWriter() = default;
+  /// Create a writer for the given buffer, capacity includes the space for the null terminator.
+  JsonWriter(char *buffer, size_t capacity);
+
+  void begin_object();
+  void begin_object(const char *key);
+  void end_object();
+  void begin_array(const char *key);
+  void end_array();
+
+  void add(const char *key, const char *value);
+  void add(const char *key, const std::string &value);
+  void add(const char *key, bool value);
+  void add(const char *key, float value);
+  template<typename T> typename std::enable_if<std::is_integral<T>::value>::type add(const char *key, T value) {
+    this->write_key_(key);
+    if (std::is_signed<T>::value) {
+      this->write_int_(static_cast<int32_t>(value));
+    } else {
+      this->write_uint_(static_cast<uint32_t>(value));
+    }
+  }
+
+  /// Add a string element to the current array.
+  void add(const char *value);
+  void add(const std::string &value);
+
+  /// The length of the output so far, including the part that didn't fit into the buffer.
+  size_t length() const;
+  /// Whether the whole output and its null terminator fit into the buffer.
+  bool fits() const;
+  /// Null terminate the output, returns false if it didn't fit into the buffer.
+  bool finish();
+
+ protected:
+  void begin_value_();
+  void write_key_(const char *key);
+  void push_(char c);
+  void pop_(char c);
+  void write_(char c) {
+    if (this->length_ < this->capacity_)
+      this->buffer_[this->length_] = c;
+    this->length_++;
+  }
+  void write_(const char *str, size_t len);
+  void write_string_(const char *str, size_t len);
+  void write_int_(int32_t value);
+  void write_uint_(uint32_t value);
+
+  char *buffer_{nullptr};
+  size_t capacity_{0};
+  size_t length_{0};
+  /// Bit n is set while the container at depth n has no members yet.
+  uint32_t first_{0};
+  uint8_t depth_{0};
+};
+
+}  // namespace json
+}  // namespace esphome
@@ -40,6 +40,8 @@ from .types import (  # noqa
 CODEOWNERS = ["@esphome/core"]
 IS_PLATFORM_COMPONENT = True
 
+CONF_TRANSITION_BUFFER_SIZE = "transition_buffer_size"
+
 LightRestoreMode = light_ns.enum("LightRestoreMode")
 RESTORE_MODES = {
     "RESTORE_DEFAULT_OFF": LightRestoreMode.LIGHT_RESTORE_DEFAULT_OFF,
@@ -98,6 +100,9 @@ ADDRESSABLE_LIGHT_SCHEMA = RGB_LIGHT_SCHEMA.extend(
             [cv.percentage], cv.Length(min=3, max=4)
         ),
         cv.Optional(CONF_POWER_SUPPLY): cv.use_id(power_supply.PowerSupply),
+        cv.SplitDefault(
+            CONF_TRANSITION_BUFFER_SIZE, esp8266="1kB", esp32="4kB"
+        ): cv.All(cv.validate_bytes, cv.int_range(min=0, max=65535)),
     }
 )
 
@@ -130,6 +135,11 @@ def setup_light_core_(light_var, output_var, config):
     if CONF_COLOR_CORRECT in config:
         cg.add(output_var.set_correction(*config[CONF_COLOR_CORRECT]))
 
+    if CONF_TRANSITION_BUFFER_SIZE in config:
+        cg.add(
+            output_var.set_transition_buffer_size(config[CONF_TRANSITION_BUFFER_SIZE])
+        )
+
     if CONF_POWER_SUPPLY in config:
         var_ = yield cg.get_variable(config[CONF_POWER_SUPPLY])
         cg.add(output_var.set_power_supply(var_))
@@ -1,5 +1,6 @@
 #include "addressable_light.h"
 #include "esphome/core/log.h"
+#include <cstring>
 
 namespace esphome {
 namespace light {
@@ -73,7 +74,78 @@ Color ESPHSVColor::to_rgb() const {
   return rgb;
 }
 
+// Ranges with more pixels than this build a lookup table per channel instead of correcting every pixel.
+static const int32_t MAP_LUT_THRESHOLD = 256;
+
+bool HOT ESPRangeView::fill_raw_(const Color &raw, uint8_t channel_mask) {
+  ESPPixelSpan span = this->parent_->get_pixel_span();
+  if (!span.is_valid())
+    return false;
+
+  const uint8_t channels = span.channels();
+  channel_mask &= (1 << channels) - 1;
+  uint8_t *end = span.pixel(this->end_);
+  if (channel_mask == 0b0111 && channels == 3) {
+    uint8_t pixel[3];
+    for (uint8_t c = 0; c < 3; c++)
+      pixel[span.offsets[c]] = raw.raw[c];
+    for (uint8_t *p = span.pixel(this->begin_); p != end; p += 3) {
+      p[0] = pixel[0];
+      p[1] = pixel[1];
+      p[2] = pixel[2];
+    }
+    return true;
+  }
+  if (channel_mask == 0b1111) {
+    uint32_t pixel;
+    auto *bytes = reinterpret_cast<uint8_t *>(&pixel);
+    for (uint8_t c = 0; c < 4; c++)
+      bytes[span.offsets[c]] = raw.raw[c];
+    for (uint8_t *p = span.pixel(this->begin_); p != end; p += 4)
+      memcpy(p, &pixel, 4);
+    return true;
+  }
+  for (uint8_t c = 0; c < channels; c++) {
+    if ((channel_mask & (1 << c)) == 0)
+      continue;
+    const uint8_t value = raw.raw[c];
+    for (uint8_t *p = span.pixel(this->begin_) + span.offsets[c]; p < end; p += span.stride)
+      *p = value;
+  }
+  return true;
+}
+
+template<typename F> bool HOT ESPRangeView::map_(F func) {
+  ESPPixelSpan span = this->parent_->get_pixel_span();
+  if (!span.is_valid())
+    return false;
+
+  const ESPColorCorrection &correction = this->parent_->get_correction();
+  const uint8_t channels = span.channels();
+  uint8_t *begin = span.pixel(this->begin_);
+  uint8_t *end = span.pixel(this->end_);
+  if (this->size() < MAP_LUT_THRESHOLD) {
+    for (uint8_t c = 0; c < channels; c++) {
+      for (uint8_t *p = begin + span.offsets[c]; p < end; p += span.stride)
+        *p = correction.color_correct_channel(c, func(c, correction.color_uncorrect_channel(c, *p)));
+    }
+    return true;
+  }
+
+  // the result only depends on the channel and its current value, so compute it once for every possible value
+  uint8_t lut[256];
+  for (uint8_t c = 0; c < channels; c++) {
+    for (uint16_t v = 0; v < 256; v++)
+      lut[v] = correction.color_correct_channel(c, func(c, correction.color_uncorrect_channel(c, v)));
+    for (uint8_t *p = begin + span.offsets[c]; p < end; p += span.stride)
+      *p = lut[*p];
+  }
+  return true;
+}
+
 void ESPRangeView::set(const Color &color) {
+  if (this->fill_raw_(this->parent_->get_correction().color_correct(color), 0b1111))
+    return;
   for (int32_t i = this->begin_; i < this->end_; i++) {
     (*this->parent_)[i] = color;
   }
@@ -85,18 +157,26 @@ ESPColorView ESPRangeView::operator[](int32_t index) const {
 ESPRangeIterator ESPRangeView::begin() { return {*this, this->begin_}; }
 ESPRangeIterator ESPRangeView::end() { return {*this, this->end_}; }
 void ESPRangeView::set_red(uint8_t red) {
+  if (this->fill_raw_(Color(this->parent_->get_correction().color_correct_red(red), 0, 0, 0), 0b0001))
+    return;
   for (auto c : *this)
     c.set_red(red);
 }
 void ESPRangeView::set_green(uint8_t green) {
+  if (this->fill_raw_(Color(0, this->parent_->get_correction().color_correct_green(green), 0, 0), 0b0010))
+    return;
   for (auto c : *this)
     c.set_green(green);
 }
 void ESPRangeView::set_blue(uint8_t blue) {
+  if (this->fill_raw_(Color(0, 0, this->parent_->get_correction().color_correct_blue(blue), 0), 0b0100))
+    return;
   for (auto c : *this)
     c.set_blue(blue);
 }
 void ESPRangeView::set_white(uint8_t white) {
+  if (this->fill_raw_(Color(0, 0, 0, this->parent_->get_correction().color_correct_white(white)), 0b1000))
+    return;
   for (auto c : *this)
     c.set_white(white);
 }
@@ -105,21 +185,39 @@ void ESPRangeView::set_effect_data(uint8_t effect_data) {
     c.set_effect_data(effect_data);
 }
 void ESPRangeView::fade_to_white(uint8_t amnt) {
+  if (this->map_([amnt](uint8_t, uint8_t v) -> uint8_t { return 255 - esp_scale8(v, amnt); }))
+    return;
   for (auto c : *this)
     c.fade_to_white(amnt);
 }
 void ESPRangeView::fade_to_black(uint8_t amnt) {
+  if (this->map_([amnt](uint8_t, uint8_t v) -> uint8_t { return esp_scale8(v, amnt); }))
+    return;
   for (auto c : *this)
     c.fade_to_black(amnt);
 }
 void ESPRangeView::lighten(uint8_t delta) {
+  if (this->map_([delta](uint8_t, uint8_t v) -> uint8_t { return v > 255 - delta ? 255 : v + delta; }))
+    return;
   for (auto c : *this)
     c.lighten(delta);
 }
 void ESPRangeView::darken(uint8_t delta) {
+  if (this->map_([delta](uint8_t, uint8_t v) -> uint8_t { return v < delta ? 0 : v - delta; }))
+    return;
   for (auto c : *this)
     c.darken(delta);
 }
+void ESPRangeView::blend(const Color &add, uint8_t inv_alpha) {
+  auto func = [add, inv_alpha](uint8_t c, uint8_t v) -> uint8_t {
+    uint8_t scaled = esp_scale8(v, inv_alpha);
+    return scaled > 255 - add.raw[c] ? 255 : scaled + add.raw[c];
+  };
+  if (this->map_(func))
+    return;
+  for (auto c : *this)
+    c = add + c.get() * inv_alpha;
+}
 ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {
   // If size doesn't match, error (todo warning)
   if (rhs.size() != this->size())
@@ -135,6 +233,13 @@ ESPRangeView &ESPRangeView::operator=(const ESPRangeView &rhs) {
   if (rhs.begin_ == this->begin_)
     return *this;
 
+  ESPPixelSpan span = this->parent_->get_pixel_span();
+  if (span.is_valid()) {
+    // same light and correction, move the raw pixels
+    memmove(span.pixel(this->begin_), span.pixel(rhs.begin_), this->size() * span.stride);
+    return *this;
+  }
+
   if (rhs.begin_ > this->begin_) {
     // Copy from left
     for (int32_t i = 0; i < this->size(); i++) {
@@ -192,22 +297,24 @@ void AddressableLight::write_state(LightState *state) {
   this->last_transition_progress_ = 0.0f;
   this->accumulated_alpha_ = 0.0f;
 
-  if (this->is_effect_active())
+  if (this->is_effect_active()) {
+    this->transition_transformer_ = nullptr;
     return;
+  }
 
   // don't use LightState helper, gamma correction+brightness is handled by ESPColorView
 
   if (state->transformer_ == nullptr || !state->transformer_->is_transition()) {
     // no transformer active or non-transition one
+    this->transition_transformer_ = nullptr;
     this->all() = esp_color_from_light_color_values(val);
   } else {
     // transition transformer active, activate specialized transition for addressable effects
     // instead of using a unified transition for all LEDs, we use the current state each LED as the
     // start. Warning: ugly
 
-    // We can't use a direct lerp smoothing here though - that would require creating a copy of the original
-    // state of each LED at the start of the transition
-    // Instead, we "fake" the look of the LERP by using an exponential average over time and using
+    // If the strip fits the transition buffer, we keep a copy of the original state of each LED and lerp
+    // from there. Otherwise, we "fake" the look of the LERP by using an exponential average over time and using
     // dynamically-calculated alpha values to match the look of the
 
     float new_progress = state->transformer_->get_progress();
@@ -225,6 +332,11 @@ void AddressableLight::write_state(LightState *state) {
     // w is not scaled by brightness
     target_color.w = orig_w;
 
+    if (this->write_transition_snapshot_(state->transformer_.get(), target_color, new_smoothed)) {
+      this->schedule_show();
+      return;
+    }
+
     float denom = (1.0f - new_smoothed);
     float alpha = denom == 0.0f ? 0.0f : (new_smoothed - prev_smoothed) / denom;
 
@@ -246,14 +358,72 @@ void AddressableLight::write_state(LightState *state) {
       uint8_t inv_alpha8 = 255 - alpha8;
       Color add = target_color * alpha8;
 
-      for (auto led : *this)
-        led = add + led.get() * inv_alpha8;
+      this->all().blend(add, inv_alpha8);
     }
   }
 
   this->schedule_show();
 }
 
+static inline uint8_t lerp8(uint8_t from, uint8_t to, uint16_t amount) {
+  return from + (int32_t(to) - int32_t(from)) * amount / 256;
+}
+
+bool AddressableLight::write_transition_snapshot_(const LightTransformer *transformer, const Color &target,
+                                                  float progress) {
+  const int32_t size = this->size();
+  const uint8_t channels = this->get_traits().get_supports_rgb_white_value() ? 4 : 3;
+  const size_t needed = size_t(size) * channels;
+  if (needed == 0 || needed > this->transition_buffer_size_)
+    return false;
+
+  if (this->transition_transformer_ != transformer || this->transition_start_time_ != transformer->get_start_time()) {
+    // new transition, remember where every LED starts from
+    if (this->transition_snapshot_capacity_ < needed) {
+      this->transition_snapshot_.reset(new uint8_t[needed]);
+      this->transition_snapshot_capacity_ = needed;
+    }
+    uint8_t *snapshot = this->transition_snapshot_.get();
+    for (auto led : *this) {
+      Color color = led.get();
+      for (uint8_t c = 0; c < channels; c++)
+        *snapshot++ = color.raw[c];
+    }
+    this->transition_transformer_ = transformer;
+    this->transition_start_time_ = transformer->get_start_time();
+  }
+
+  // fixed point progress, 256 is the target color
+  const uint16_t amount = static_cast<uint16_t>(clamp(progress, 0.0f, 1.0f) * 256.0f + 0.5f);
+  const uint8_t *snapshot = this->transition_snapshot_.get();
+  const ESPPixelSpan span = this->get_pixel_span();
+  if (!span.is_valid() || span.channels() != channels) {
+    for (int32_t i = 0; i < size; i++, snapshot += channels) {
+      uint8_t white = channels == 4 ? lerp8(snapshot[3], target.w, amount) : 0;
+      (*this)[i] = Color(lerp8(snapshot[0], target.r, amount), lerp8(snapshot[1], target.g, amount),
+                         lerp8(snapshot[2], target.b, amount), white);
+    }
+    return true;
+  }
+
+  uint8_t lut[256];
+  for (uint8_t c = 0; c < channels; c++) {
+    uint8_t *pixel = span.data + span.offsets[c];
+    const uint8_t *start = snapshot + c;
+    if (size < MAP_LUT_THRESHOLD) {
+      for (int32_t i = 0; i < size; i++, pixel += span.stride, start += channels)
+        *pixel = this->correction_.color_correct_channel(c, lerp8(*start, target.raw[c], amount));
+      continue;
+    }
+    // every LED goes to the same target, so the result only depends on the start value
+    for (uint16_t v = 0; v < 256; v++)
+      lut[v] = this->correction_.color_correct_channel(c, lerp8(v, target.raw[c], amount));
+    for (int32_t i = 0; i < size; i++, pixel += span.stride, start += channels)
+      *pixel = lut[*start];
+  }
+  return true;
+}
+
 void ESPColorCorrection::calculate_gamma_table(float gamma) {
   for (uint16_t i = 0; i < 256; i++) {
     // corrected = val ^ gamma
@@ -102,6 +102,31 @@ class ESPColorCorrection {
     uint8_t res = uncorrected / this->max_brightness_.white;
     return res;
   }
+  /// Correct a single channel, 0 = red, 1 = green, 2 = blue, 3 = white.
+  inline uint8_t color_correct_channel(uint8_t channel, uint8_t value) const ALWAYS_INLINE {
+    switch (channel) {
+      case 0:
+        return this->color_correct_red(value);
+      case 1:
+        return this->color_correct_green(value);
+      case 2:
+        return this->color_correct_blue(value);
+      default:
+        return this->color_correct_white(value);
+    }
+  }
+  inline uint8_t color_uncorrect_channel(uint8_t channel, uint8_t value) const ALWAYS_INLINE {
+    switch (channel) {
+      case 0:
+        return this->color_uncorrect_red(value);
+      case 1:
+        return this->color_uncorrect_green(value);
+      case 2:
+        return this->color_uncorrect_blue(value);
+      default:
+        return this->color_uncorrect_white(value);
+    }
+  }
 
  protected:
   uint8_t gamma_table_[256];
@@ -110,6 +135,21 @@ class ESPColorCorrection {
   uint8_t local_brightness_{255};
 };
 
+/// Contiguous pixel memory of an addressable light, in the channel order of the driver.
+struct ESPPixelSpan {
+  /// First byte of the first pixel, nullptr if the light has no contiguous buffer.
+  uint8_t *data{nullptr};
+  int32_t size{0};
+  /// Bytes per pixel, 3 for RGB and 4 for RGBW lights.
+  uint8_t stride{3};
+  /// Byte offset of the red, green, blue and white channel within a pixel, white is only used with a stride of 4.
+  uint8_t offsets[4]{0, 1, 2, 3};
+
+  bool is_valid() const { return this->data != nullptr; }
+  uint8_t channels() const { return this->stride == 4 ? 4 : 3; }
+  uint8_t *pixel(int32_t index) const { return this->data + index * this->stride; }
+};
+
 class ESPColorSettable {
  public:
   virtual void set(const Color &color) = 0;
@@ -250,11 +290,18 @@ class ESPRangeView : public ESPColorSettable {
   void fade_to_black(uint8_t amnt) override;
   void lighten(uint8_t delta) override;
   void darken(uint8_t delta) override;
+  /// Set every LED to add + color * inv_alpha, with saturating addition.
+  void blend(const Color &add, uint8_t inv_alpha);
   int32_t size() const { return this->end_ - this->begin_; }
 
  protected:
   friend ESPRangeIterator;
 
+  /// Write corrected channel values to the selected channels (bit 0 = red ... bit 3 = white) of the whole range.
+  bool fill_raw_(const Color &raw, uint8_t channel_mask);
+  /// Replace every uncorrected channel value v of the range with func(channel, v).
+  template<typename F> bool map_(F func);
+
   AddressableLight *parent_;
   int32_t begin_;
   int32_t end_;
@@ -287,6 +334,9 @@ class AddressableLight : public LightOutput, public Component {
     return ESPRangeView(this, from, to);
   }
   ESPRangeView all() { return ESPRangeView(this, 0, this->size()); }
+  /// Raw pixel buffer for bulk access, not valid if the output has no contiguous buffer. Values are color corrected.
+  ESPPixelSpan get_pixel_span() const { return this->get_pixel_span_internal(); }
+  const ESPColorCorrection &get_correction() const { return this->correction_; }
   ESPRangeIterator begin() { return this->all().begin(); }
   ESPRangeIterator end() { return this->all().end(); }
   void shift_left(int32_t amnt) {
@@ -319,6 +369,14 @@ class AddressableLight : public LightOutput, public Component {
     this->state_parent_ = state;
   }
   void schedule_show() { this->next_show_ = true; }
+  /** Set the memory budget for exact transitions, in bytes.
+   *
+   * Transitions snapshot the color of every LED when they start and interpolate from there, which needs 3 bytes
+   * (4 with white) per LED. Strips that don't fit use an approximated transition without extra memory.
+   */
+  void set_transition_buffer_size(size_t transition_buffer_size) {
+    this->transition_buffer_size_ = transition_buffer_size;
+  }
 
 #ifdef USE_POWER_SUPPLY
   void set_power_supply(power_supply::PowerSupply *power_supply) { this->power_.set_parent(power_supply); }
@@ -331,6 +389,17 @@ class AddressableLight : public LightOutput, public Component {
   void mark_shown_() {
     this->next_show_ = false;
 #ifdef USE_POWER_SUPPLY
+    ESPPixelSpan span = this->get_pixel_span();
+    if (span.is_valid()) {
+      for (int32_t i = 0, len = span.size * span.stride; i < len; i++) {
+        if (span.data[i] != 0) {
+          this->power_.request();
+          return;
+        }
+      }
+      this->power_.unrequest();
+      return;
+    }
     for (auto c : *this) {
       if (c.get().is_on()) {
         this->power_.request();
@@ -341,6 +410,10 @@ class AddressableLight : public LightOutput, public Component {
 #endif
   }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
+  /// Outputs with a contiguous pixel buffer return it here to enable the bulk operations of ESPRangeView.
+  virtual ESPPixelSpan get_pixel_span_internal() const { return {}; }
+  /// Interpolate every LED from the snapshot towards target, returns false if the strip doesn't fit the budget.
+  bool write_transition_snapshot_(const LightTransformer *transformer, const Color &target, float progress);
 
   bool effect_active_{false};
   bool next_show_{true};
@@ -351,6 +424,13 @@ class AddressableLight : public LightOutput, public Component {
   LightState *state_parent_{nullptr};
   float last_transition_progress_{0.0f};
   float accumulated_alpha_{0.0f};
+  size_t transition_buffer_size_{0};
+  /// Uncorrected color of every LED at the start of the current transition.
+  std::unique_ptr<uint8_t[]> transition_snapshot_;
+  size_t transition_snapshot_capacity_{0};
+  /// Transition the snapshot belongs to, nullptr if there is none.
+  const LightTransformer *transition_transformer_{nullptr};
+  uint32_t transition_start_time_{0};
 };
 
 }  // namespace light
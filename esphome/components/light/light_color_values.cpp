@@ -0,0 +1,58 @@
+#include "light_color_values.h"
+
+#ifdef USE_LIGHT_FIXED_POINT
+
+namespace esphome {
+namespace light {
+
+// 64 segments with linear interpolation keep the error for gamma 2.8 below 0.0002
+static const uint8_t GAMMA_TABLE_BITS = 6;
+static const uint8_t GAMMA_TABLE_SHIFT = 16 - GAMMA_TABLE_BITS;
+static const uint8_t GAMMA_TABLE_CACHE_SIZE = 2;
+
+struct GammaTable {
+  float gamma;
+  uint16_t values[(1 << GAMMA_TABLE_BITS) + 1];
+};
+
+static GammaTable gamma_tables[GAMMA_TABLE_CACHE_SIZE];  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint8_t gamma_tables_next = 0;                    // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static const GammaTable &get_gamma_table(float gamma) {
+  for (auto &table : gamma_tables) {
+    if (table.gamma == gamma)
+      return table;
+  }
+  // usually all lights share one gamma value, so this only runs once per gamma
+  GammaTable &table = gamma_tables[gamma_tables_next];
+  gamma_tables_next = (gamma_tables_next + 1) % GAMMA_TABLE_CACHE_SIZE;
+  table.gamma = gamma;
+  for (uint32_t i = 0; i <= (1 << GAMMA_TABLE_BITS); i++) {
+    float value = i / float(1 << GAMMA_TABLE_BITS);
+    table.values[i] = float_to_fixed16(gamma_correct(value, gamma));
+  }
+  return table;
+}
+
+uint16_t gamma_correct_fixed16(uint16_t value, float gamma) {
+  if (value == 0)
+    return 0;
+  if (gamma <= 0.0f)
+    return value;
+
+  const GammaTable &table = get_gamma_table(gamma);
+  // stretch 0..65535 to 0..65536, so that the last table entry is reached by 65535
+  const uint32_t scaled = uint32_t(value) + (value >> 15);
+  const uint16_t index = scaled >> GAMMA_TABLE_SHIFT;
+  if (index == (1 << GAMMA_TABLE_BITS))
+    return table.values[index];
+  const uint32_t fraction = scaled & ((1 << GAMMA_TABLE_SHIFT) - 1);
+  const uint16_t low = table.values[index];
+  const uint16_t high = table.values[index + 1];
+  return low + ((int32_t(high) - int32_t(low)) * int32_t(fraction) >> GAMMA_TABLE_SHIFT);
+}
+
+}  // namespace light
+}  // namespace esphome
+
+#endif
@@ -11,12 +11,35 @@
 namespace esphome {
 namespace light {
 
+#ifdef USE_LIGHT_FIXED_POINT
+/// Convert a float in the range 0.0 to 1.0 to an unsigned 16 bit fixed point value, where 65535 is 1.0.
+inline uint16_t float_to_fixed16(float value) { return static_cast<uint16_t>(value * 65535.0f + 0.5f); }
+inline float fixed16_to_float(uint16_t value) { return value * (1.0f / 65535.0f); }
+/// Multiply two fixed point values, rounded.
+inline uint16_t fixed16_mul(uint16_t a, uint16_t b) {
+  uint32_t product = uint32_t(a) * b + 32768UL;
+  return (product + (product >> 16)) >> 16;
+}
+/// Interpolate between two fixed point values, rounded. Completion 0 gives exactly start, 65535 exactly end.
+inline uint16_t fixed16_lerp(uint16_t completion, uint16_t start, uint16_t end) {
+  // the magnitude of the product fits into 32 bits, a signed product wouldn't
+  if (end >= start)
+    return start + (uint32_t(end - start) * completion + 32767UL) / 65535UL;
+  return start - (uint32_t(start - end) * completion + 32767UL) / 65535UL;
+}
+/// Fixed point version of gamma_correct(), based on a lookup table per gamma value.
+uint16_t gamma_correct_fixed16(uint16_t value, float gamma);
+#endif
+
 /** This class represents the color state for a light object.
  *
  * All values in this class are represented using floats in the range from 0.0 (off) to 1.0 (on).
  * Not all values have to be populated though, for example a simple monochromatic light only needs
  * to access the state and brightness attributes.
  *
+ * With USE_LIGHT_FIXED_POINT, the values are stored as 16 bit fixed point numbers and transitions and gamma
+ * correction run on integers, the float accessors convert on the fly.
+ *
  * Please note all float values are automatically clamped.
  *
  * state - Whether the light should be on/off. Represented as a float for transitions.
@@ -29,12 +52,12 @@ class LightColorValues {
  public:
   /// Construct the LightColorValues with all attributes enabled, but state set to 0.0
   LightColorValues()
-      : state_(0.0f),
-        brightness_(1.0f),
-        red_(1.0f),
-        green_(1.0f),
-        blue_(1.0f),
-        white_(1.0f),
+      : state_(to_value_(0.0f)),
+        brightness_(to_value_(1.0f)),
+        red_(to_value_(1.0f)),
+        green_(to_value_(1.0f)),
+        blue_(to_value_(1.0f)),
+        white_(to_value_(1.0f)),
         color_temperature_{1.0f} {}
 
   LightColorValues(float state, float brightness, float red, float green, float blue, float white,
@@ -94,6 +117,9 @@ class LightColorValues {
    * @return The linearly interpolated LightColorValues.
    */
   static LightColorValues lerp(const LightColorValues &start, const LightColorValues &end, float completion) {
+#ifdef USE_LIGHT_FIXED_POINT
+    return lerp_fixed16(start, end, float_to_fixed16(clamp(completion, 0.0f, 1.0f)));
+#else
     LightColorValues v;
     v.set_state(esphome::lerp(completion, start.get_state(), end.get_state()));
     v.set_brightness(esphome::lerp(completion, start.get_brightness(), end.get_brightness()));
@@ -103,8 +129,26 @@ class LightColorValues {
     v.set_white(esphome::lerp(completion, start.get_white(), end.get_white()));
     v.set_color_temperature(esphome::lerp(completion, start.get_color_temperature(), end.get_color_temperature()));
     return v;
+#endif
   }
 
+#ifdef USE_LIGHT_FIXED_POINT
+  /// Same as lerp(), with the completion as fixed point value (65535 -> end).
+  static LightColorValues lerp_fixed16(const LightColorValues &start, const LightColorValues &end,
+                                       uint16_t completion) {
+    LightColorValues v;
+    v.state_ = fixed16_lerp(completion, start.state_, end.state_);
+    v.brightness_ = fixed16_lerp(completion, start.brightness_, end.brightness_);
+    v.red_ = fixed16_lerp(completion, start.red_, end.red_);
+    v.green_ = fixed16_lerp(completion, start.green_, end.green_);
+    v.blue_ = fixed16_lerp(completion, start.blue_, end.blue_);
+    v.white_ = fixed16_lerp(completion, start.white_, end.white_);
+    v.set_color_temperature(esphome::lerp(fixed16_to_float(completion), start.get_color_temperature(),
+                                          end.get_color_temperature()));
+    return v;
+  }
+#endif
+
 #ifdef USE_JSON
   /** Dump this color into a JsonObject. Only dumps values if the corresponding traits are marked supported by traits.
    *
@@ -171,29 +215,29 @@ class LightColorValues {
   }
 
   /// Convert these light color values to a binary representation and write them to binary.
-  void as_binary(bool *binary) const { *binary = this->state_ == 1.0f; }
+  void as_binary(bool *binary) const { *binary = this->state_ == to_value_(1.0f); }
 
   /// Convert these light color values to a brightness-only representation and write them to brightness.
   void as_brightness(float *brightness, float gamma = 0) const {
-    *brightness = gamma_correct(this->state_ * this->brightness_, gamma);
+    *brightness = gamma_(mul_(this->state_, this->brightness_), gamma);
   }
 
   /// Convert these light color values to an RGB representation and write them to red, green, blue.
   void as_rgb(float *red, float *green, float *blue, float gamma = 0, bool color_interlock = false) const {
-    float brightness = this->state_ * this->brightness_;
+    value_t brightness = mul_(this->state_, this->brightness_);
     if (color_interlock) {
-      brightness = brightness * (1.0f - this->white_);
+      brightness = mul_(brightness, to_value_(1.0f) - this->white_);
     }
-    *red = gamma_correct(brightness * this->red_, gamma);
-    *green = gamma_correct(brightness * this->green_, gamma);
-    *blue = gamma_correct(brightness * this->blue_, gamma);
+    *red = gamma_(mul_(brightness, this->red_), gamma);
+    *green = gamma_(mul_(brightness, this->green_), gamma);
+    *blue = gamma_(mul_(brightness, this->blue_), gamma);
   }
 
   /// Convert these light color values to an RGBW representation and write them to red, green, blue, white.
   void as_rgbw(float *red, float *green, float *blue, float *white, float gamma = 0,
                bool color_interlock = false) const {
     this->as_rgb(red, green, blue, gamma, color_interlock);
-    *white = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    *white = gamma_(mul_(mul_(this->state_, this->brightness_), this->white_), gamma);
   }
 
   /// Convert these light color values to an RGBWW representation with the given parameters.
@@ -204,7 +248,7 @@ class LightColorValues {
     const float color_temp = clamp(this->color_temperature_, color_temperature_cw, color_temperature_ww);
     const float ww_fraction = (color_temp - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
     const float cw_fraction = 1.0f - ww_fraction;
-    const float white_level = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    const float white_level = gamma_(mul_(mul_(this->state_, this->brightness_), this->white_), gamma);
     *cold_white = white_level * cw_fraction;
     *warm_white = white_level * ww_fraction;
     if (!constant_brightness) {
@@ -220,7 +264,7 @@ class LightColorValues {
     const float color_temp = clamp(this->color_temperature_, color_temperature_cw, color_temperature_ww);
     const float ww_fraction = (color_temp - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
     const float cw_fraction = 1.0f - ww_fraction;
-    const float white_level = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    const float white_level = gamma_(mul_(mul_(this->state_, this->brightness_), this->white_), gamma);
     *cold_white = white_level * cw_fraction;
     *warm_white = white_level * ww_fraction;
     if (!constant_brightness) {
@@ -238,38 +282,38 @@ class LightColorValues {
   bool operator!=(const LightColorValues &rhs) const { return !(rhs == *this); }
 
   /// Get the state of these light color values. In range from 0.0 (off) to 1.0 (on)
-  float get_state() const { return this->state_; }
+  float get_state() const { return from_value_(this->state_); }
   /// Get the binary true/false state of these light color values.
-  bool is_on() const { return this->get_state() != 0.0f; }
+  bool is_on() const { return this->state_ != 0; }
   /// Set the state of these light color values. In range from 0.0 (off) to 1.0 (on)
-  void set_state(float state) { this->state_ = clamp(state, 0.0f, 1.0f); }
+  void set_state(float state) { this->state_ = to_value_(clamp(state, 0.0f, 1.0f)); }
   /// Set the state of these light color values as a binary true/false.
-  void set_state(bool state) { this->state_ = state ? 1.0f : 0.0f; }
+  void set_state(bool state) { this->state_ = to_value_(state ? 1.0f : 0.0f); }
 
   /// Get the brightness property of these light color values. In range 0.0 to 1.0
-  float get_brightness() const { return this->brightness_; }
+  float get_brightness() const { return from_value_(this->brightness_); }
   /// Set the brightness property of these light color values. In range 0.0 to 1.0
-  void set_brightness(float brightness) { this->brightness_ = clamp(brightness, 0.0f, 1.0f); }
+  void set_brightness(float brightness) { this->brightness_ = to_value_(clamp(brightness, 0.0f, 1.0f)); }
 
   /// Get the red property of these light color values. In range 0.0 to 1.0
-  float get_red() const { return this->red_; }
+  float get_red() const { return from_value_(this->red_); }
   /// Set the red property of these light color values. In range 0.0 to 1.0
-  void set_red(float red) { this->red_ = clamp(red, 0.0f, 1.0f); }
+  void set_red(float red) { this->red_ = to_value_(clamp(red, 0.0f, 1.0f)); }
 
   /// Get the green property of these light color values. In range 0.0 to 1.0
-  float get_green() const { return this->green_; }
+  float get_green() const { return from_value_(this->green_); }
   /// Set the green property of these light color values. In range 0.0 to 1.0
-  void set_green(float green) { this->green_ = clamp(green, 0.0f, 1.0f); }
+  void set_green(float green) { this->green_ = to_value_(clamp(green, 0.0f, 1.0f)); }
 
   /// Get the blue property of these light color values. In range 0.0 to 1.0
-  float get_blue() const { return this->blue_; }
+  float get_blue() const { return from_value_(this->blue_); }
   /// Set the blue property of these light color values. In range 0.0 to 1.0
-  void set_blue(float blue) { this->blue_ = clamp(blue, 0.0f, 1.0f); }
+  void set_blue(float blue) { this->blue_ = to_value_(clamp(blue, 0.0f, 1.0f)); }
 
   /// Get the white property of these light color values. In range 0.0 to 1.0
-  float get_white() const { return white_; }
+  float get_white() const { return from_value_(this->white_); }
   /// Set the white property of these light color values. In range 0.0 to 1.0
-  void set_white(float white) { this->white_ = clamp(white, 0.0f, 1.0f); }
+  void set_white(float white) { this->white_ = to_value_(clamp(white, 0.0f, 1.0f)); }
 
   /// Get the color temperature property of these light color values in mired.
   float get_color_temperature() const { return this->color_temperature_; }
@@ -279,12 +323,26 @@ class LightColorValues {
   }
 
  protected:
-  float state_;  ///< ON / OFF, float for transition
-  float brightness_;
-  float red_;
-  float green_;
-  float blue_;
-  float white_;
+#ifdef USE_LIGHT_FIXED_POINT
+  using value_t = uint16_t;
+  static value_t to_value_(float value) { return float_to_fixed16(value); }
+  static float from_value_(value_t value) { return fixed16_to_float(value); }
+  static value_t mul_(value_t a, value_t b) { return fixed16_mul(a, b); }
+  static float gamma_(value_t value, float gamma) { return fixed16_to_float(gamma_correct_fixed16(value, gamma)); }
+#else
+  using value_t = float;
+  static value_t to_value_(float value) { return value; }
+  static float from_value_(value_t value) { return value; }
+  static value_t mul_(value_t a, value_t b) { return a * b; }
+  static float gamma_(value_t value, float gamma) { return gamma_correct(value, gamma); }
+#endif
+
+  value_t state_;  ///< ON / OFF, fractional for transition
+  value_t brightness_;
+  value_t red_;
+  value_t green_;
+  value_t blue_;
+  value_t white_;
   float color_temperature_;  ///< Color Temperature in Mired
 };
 
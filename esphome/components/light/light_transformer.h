@@ -32,6 +32,23 @@ class LightTransformer {
   virtual bool is_transition() = 0;
 
   float get_progress() { return clamp((millis() - this->start_time_) / float(this->length_), 0.0f, 1.0f); }
+#ifdef USE_LIGHT_FIXED_POINT
+  /// Progress as fixed point value, 65535 is finished.
+  uint16_t get_progress_fixed16() {
+    uint32_t elapsed = millis() - this->start_time_;
+    if (elapsed >= this->length_)
+      return 65535;
+    // scale both down until the product fits into 32 bits, there's no hardware 64 bit division
+    uint32_t length = this->length_;
+    while (length > 65535) {
+      length >>= 1;
+      elapsed >>= 1;
+    }
+    return elapsed * 65535 / length;
+  }
+#endif
+
+  uint32_t get_start_time() const { return this->start_time_; }
 
  protected:
   const LightColorValues &get_start_values_() const { return this->start_values_; }
@@ -61,14 +78,28 @@ class LightTransitionTransformer : public LightTransformer {
   }
 
   LightColorValues get_values() override {
+#ifdef USE_LIGHT_FIXED_POINT
+    uint16_t v = LightTransitionTransformer::smoothed_progress_fixed16(this->get_progress_fixed16());
+    return LightColorValues::lerp_fixed16(this->get_start_values_(), this->get_target_values_(), v);
+#else
     float v = LightTransitionTransformer::smoothed_progress(this->get_progress());
     return LightColorValues::lerp(this->get_start_values_(), this->get_target_values_(), v);
+#endif
   }
 
   bool publish_at_end() override { return false; }
   bool is_transition() override { return true; }
 
   static float smoothed_progress(float x) { return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f); }
+#ifdef USE_LIGHT_FIXED_POINT
+  static uint16_t smoothed_progress_fixed16(uint16_t x) {
+    // same polynomial as smoothed_progress() with 16 fractional bits
+    int64_t inner = (int64_t(x) * (6 * int32_t(x) - 15 * 65536L) >> 16) + 10 * 65536L;
+    int64_t cube = (int64_t(x) * x >> 16) * x >> 16;
+    int64_t result = cube * inner >> 16;
+    return result > 65535 ? 65535 : (result < 0 ? 0 : uint16_t(result));
+  }
+#endif
 };
 
 class LightFlashTransformer : public LightTransformer {
@@ -98,6 +98,7 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_BINARY_LOG_BUFFER_SIZE = "binary_log_buffer_size"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -120,6 +121,9 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.Optional(CONF_BINARY_LOG_BUFFER_SIZE): cv.All(
+                cv.validate_bytes, cv.int_range(min=256, max=65535)
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
@@ -135,6 +139,9 @@ def to_code(config):
         HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]],
     )
     log = cg.Pvariable(config[CONF_ID], rhs)
+    if CONF_BINARY_LOG_BUFFER_SIZE in config:
+        cg.add_define("USE_LOGGER_BINARY_LOG")
+        cg.add(log.set_binary_log_buffer_size(config[CONF_BINARY_LOG_BUFFER_SIZE]))
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
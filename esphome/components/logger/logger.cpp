@@ -45,6 +45,10 @@ void Logger::write_header_(int level, const char *tag, int line) {
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
   if (level > this->level_for(tag))
     return;
+#ifdef USE_LOGGER_BINARY_LOG
+  if (this->capture_binary_(level, tag, line, format, false, args))
+    return;
+#endif
 
   this->reset_buffer_();
   this->write_header_(level, tag, line);
@@ -57,6 +61,10 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
                           va_list args) {  // NOLINT
   if (level > this->level_for(tag))
     return;
+#ifdef USE_LOGGER_BINARY_LOG
+  if (this->capture_binary_(level, tag, line, (PGM_P) format, true, args))
+    return;
+#endif
 
   this->reset_buffer_();
   // copy format string
@@ -81,16 +89,400 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif
 
+#ifdef USE_LOGGER_BINARY_LOG
+/// Records formatted per loop() iteration, so a burst of log calls doesn't stall the main loop.
+static const uint32_t BINARY_LOG_RECORDS_PER_LOOP = 16;
+/// Longest conversion specification that is captured, longer ones are formatted immediately.
+static const uint8_t MAX_SPEC_LENGTH = 15;
+
+enum class LogArgType : uint8_t {
+  NONE,
+  INT,
+  LONG,
+  LONG_LONG,
+  SIZE,
+  DOUBLE,
+  LONG_DOUBLE,
+  STRING,
+  POINTER,
+  UNSUPPORTED,
+};
+
+struct LogFormatSpec {
+  /// Number of characters including the leading '%'.
+  uint8_t length;
+  /// Number of '*' width and precision arguments preceding the value.
+  uint8_t stars;
+  LogArgType type;
+};
+
+static inline char format_char_at(const char *format, bool in_flash, size_t i) {
+#ifdef USE_STORE_LOG_STR_IN_FLASH
+  if (in_flash)
+    return pgm_read_byte(format + i);
+#endif
+  return format[i];
+}
+
+/// Parse the conversion specification starting with the '%' at format[pos].
+static LogFormatSpec parse_format_spec(const char *format, bool in_flash, size_t pos) {
+  LogFormatSpec spec{1, 0, LogArgType::UNSUPPORTED};
+  char c = format_char_at(format, in_flash, pos + spec.length);
+  if (c == '%') {
+    spec.length++;
+    spec.type = LogArgType::NONE;
+    return spec;
+  }
+  while (c == '-' || c == '+' || c == ' ' || c == '#' || c == '0')
+    c = format_char_at(format, in_flash, pos + ++spec.length);
+  if (c == '*') {
+    spec.stars++;
+    c = format_char_at(format, in_flash, pos + ++spec.length);
+  }
+  while (c >= '0' && c <= '9')
+    c = format_char_at(format, in_flash, pos + ++spec.length);
+  if (c == '.') {
+    c = format_char_at(format, in_flash, pos + ++spec.length);
+    if (c == '*') {
+      spec.stars++;
+      c = format_char_at(format, in_flash, pos + ++spec.length);
+    }
+    while (c >= '0' && c <= '9')
+      c = format_char_at(format, in_flash, pos + ++spec.length);
+  }
+
+  // length modifier, 'h' and 'hh' don't matter because of integer promotion
+  char modifier = 0;
+  if (c == 'h' || c == 'l' || c == 'j' || c == 'z' || c == 't' || c == 'L') {
+    modifier = c;
+    c = format_char_at(format, in_flash, pos + ++spec.length);
+    if ((modifier == 'h' || modifier == 'l') && c == modifier) {
+      modifier = modifier == 'l' ? 'q' : 'h';
+      c = format_char_at(format, in_flash, pos + ++spec.length);
+    }
+  }
+  spec.length++;
+  if (spec.length > MAX_SPEC_LENGTH)
+    return spec;
+
+  switch (c) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'c':
+      if (modifier == 'l')
+        spec.type = c == 'c' ? LogArgType::UNSUPPORTED : LogArgType::LONG;
+      else if (modifier == 'q' || modifier == 'j')
+        spec.type = LogArgType::LONG_LONG;
+      else if (modifier == 'z' || modifier == 't')
+        spec.type = LogArgType::SIZE;
+      else if (modifier != 'L')
+        spec.type = LogArgType::INT;
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      spec.type = modifier == 'L' ? LogArgType::LONG_DOUBLE : LogArgType::DOUBLE;
+      break;
+    case 's':
+      if (modifier == 0)
+        spec.type = LogArgType::STRING;
+      break;
+    case 'p':
+      spec.type = LogArgType::POINTER;
+      break;
+    default:
+      // %n, %S (flash strings) and unknown conversions
+      break;
+  }
+  return spec;
+}
+
+template<typename T> static inline void put_binary_arg(uint8_t *out, size_t &size, T value) {
+  if (out != nullptr)
+    memcpy(out + size, &value, sizeof(T));
+  size += sizeof(T);
+}
+template<typename T> static inline T get_binary_arg(const uint8_t *&args) {
+  T value;
+  memcpy(&value, args, sizeof(T));
+  args += sizeof(T);
+  return value;
+}
+
+/** Copy the arguments of a log call to out, or only count their size if out is nullptr.
+ *
+ * Returns false if the format string contains conversions that can't be captured.
+ */
+static bool capture_log_args(const char *format, bool in_flash, va_list args, uint8_t *out, size_t &size) {
+  size = 0;
+  for (size_t i = 0;; i++) {
+    char c = format_char_at(format, in_flash, i);
+    if (c == '\0')
+      return true;
+    if (c != '%')
+      continue;
+
+    LogFormatSpec spec = parse_format_spec(format, in_flash, i);
+    i += spec.length - 1;
+    for (uint8_t s = 0; s < spec.stars; s++)
+      put_binary_arg<int>(out, size, va_arg(args, int));
+    switch (spec.type) {
+      case LogArgType::NONE:
+        break;
+      case LogArgType::INT:
+        put_binary_arg<int>(out, size, va_arg(args, int));
+        break;
+      case LogArgType::LONG:
+        put_binary_arg<long>(out, size, va_arg(args, long));  // NOLINT
+        break;
+      case LogArgType::LONG_LONG:
+        put_binary_arg<long long>(out, size, va_arg(args, long long));  // NOLINT
+        break;
+      case LogArgType::SIZE:
+        put_binary_arg<size_t>(out, size, va_arg(args, size_t));
+        break;
+      case LogArgType::DOUBLE:
+        put_binary_arg<double>(out, size, va_arg(args, double));
+        break;
+      case LogArgType::LONG_DOUBLE:
+        put_binary_arg<long double>(out, size, va_arg(args, long double));
+        break;
+      case LogArgType::STRING: {
+        // strings are copied, the pointer may not be valid anymore when the record is formatted
+        const char *str = va_arg(args, const char *);
+        if (str == nullptr)
+          str = "(null)";
+        size_t len = strlen(str) + 1;
+        if (out != nullptr)
+          memcpy(out + size, str, len);
+        size += len;
+        break;
+      }
+      case LogArgType::POINTER:
+        put_binary_arg<const void *>(out, size, va_arg(args, const void *));
+        break;
+      case LogArgType::UNSUPPORTED:
+        return false;
+    }
+  }
+}
+
+void Logger::set_binary_log_buffer_size(size_t size) {
+  this->binary_capacity_ = size;
+  this->binary_buffer_ = new uint8_t[size];
+#ifdef ARDUINO_ARCH_ESP32
+  // called from the generated setup(), which runs in the loop task
+  this->binary_log_task_ = xTaskGetCurrentTaskHandle();
+#endif
+}
+void Logger::loop() {
+  this->drain_binary_(BINARY_LOG_RECORDS_PER_LOOP);
+  if (this->binary_head_ == this->binary_tail_)
+    this->disable_loop();
+}
+bool HOT Logger::capture_binary_(int level, const char *tag, int line, const char *format, bool format_in_flash,
+                                 va_list args) {  // NOLINT
+  if (this->binary_buffer_ == nullptr)
+    return false;
+#ifdef ARDUINO_ARCH_ESP32
+  // the ring has a single writer, calls from other tasks (esp-idf logs) are formatted right away
+  if (xTaskGetCurrentTaskHandle() != this->binary_log_task_)
+    return false;
+#endif
+  size_t args_size = 0;
+  bool supported = level > ESPHOME_LOG_LEVEL_ERROR;
+  if (supported) {
+    va_list size_args;
+    va_copy(size_args, args);
+    supported = capture_log_args(format, format_in_flash, size_args, nullptr, args_size);
+    va_end(size_args);
+  }
+  size_t size = sizeof(BinaryLogRecord) + args_size;
+  // records larger than half the ring would keep flushing it, and aren't worth deferring anyway
+  if (!supported || size > this->binary_capacity_ / 2 || size > UINT16_MAX) {
+    // keep the order: everything captured before goes out first
+    this->drain_binary_(UINT32_MAX);
+    return false;
+  }
+
+  uint8_t *out = this->reserve_binary_(size);
+  if (out == nullptr) {
+    // ring is full, format what's in it right here rather than dropping messages;
+    // an empty ring always has room for a record of at most half its size
+    this->drain_binary_(UINT32_MAX);
+    out = this->reserve_binary_(size);
+    // still full when logging from a log callback while the ring is being drained
+    if (out == nullptr)
+      return false;
+  }
+  BinaryLogRecord record{};
+  record.size = size;
+  record.level = level;
+  record.format_in_flash = format_in_flash;
+  record.line = line;
+  record.tag = tag;
+  record.format = format;
+  memcpy(out, &record, sizeof(BinaryLogRecord));
+  capture_log_args(format, format_in_flash, args, out + sizeof(BinaryLogRecord), args_size);
+  this->commit_binary_(out, size);
+
+  if (this->is_loop_disabled())
+    this->enable_loop_soon_any_context();
+  return true;
+}
+uint8_t *Logger::reserve_binary_(size_t size) {
+  size_t head = this->binary_head_;
+  size_t tail = this->binary_tail_;
+  if (head >= tail) {
+    // head must not catch up with the tail, equal offsets mean empty
+    if (this->binary_capacity_ - head > size || (this->binary_capacity_ - head == size && tail != 0))
+      return this->binary_buffer_ + head;
+    if (tail > size) {
+      // continue at the start, the drain side wraps on a 0 size or when no header fits anymore
+      if (this->binary_capacity_ - head >= sizeof(uint16_t)) {
+        const uint16_t end_marker = 0;
+        memcpy(this->binary_buffer_ + head, &end_marker, sizeof(uint16_t));
+      }
+      return this->binary_buffer_;
+    }
+    return nullptr;
+  }
+  if (tail - head > size)
+    return this->binary_buffer_ + head;
+  return nullptr;
+}
+void Logger::commit_binary_(uint8_t *record, size_t size) {
+  size_t head = (record - this->binary_buffer_) + size;
+  if (head == this->binary_capacity_)
+    head = 0;
+  this->binary_head_ = head;
+}
+void Logger::drain_binary_(uint32_t max_records) {
+  // the log callbacks run while a record is formatted and may log themselves, the record's tail is only
+  // advanced after it has been output, so a nested drain would output it again
+  if (this->binary_draining_)
+    return;
+  this->binary_draining_ = true;
+  for (uint32_t i = 0; i < max_records; i++) {
+    size_t tail = this->binary_tail_;
+    if (tail == this->binary_head_)
+      break;
+    BinaryLogRecord record;
+    if (this->binary_capacity_ - tail < sizeof(BinaryLogRecord)) {
+      tail = 0;
+    } else {
+      uint16_t size;
+      memcpy(&size, this->binary_buffer_ + tail, sizeof(uint16_t));
+      if (size == 0)
+        tail = 0;
+    }
+    memcpy(&record, this->binary_buffer_ + tail, sizeof(BinaryLogRecord));
+    this->format_binary_(record, this->binary_buffer_ + tail + sizeof(BinaryLogRecord));
+
+    tail += record.size;
+    if (tail == this->binary_capacity_)
+      tail = 0;
+    this->binary_tail_ = tail;
+  }
+  this->binary_draining_ = false;
+}
+void Logger::format_binary_(const BinaryLogRecord &record, const uint8_t *args) {
+  this->reset_buffer_();
+  this->write_header_(record.level, record.tag, record.line);
+  char spec_str[MAX_SPEC_LENGTH + 1];
+  for (size_t i = 0;; i++) {
+    char c = format_char_at(record.format, record.format_in_flash, i);
+    if (c == '\0')
+      break;
+    if (c != '%') {
+      this->write_to_buffer_(c);
+      continue;
+    }
+
+    LogFormatSpec spec = parse_format_spec(record.format, record.format_in_flash, i);
+    for (uint8_t j = 0; j < spec.length; j++)
+      spec_str[j] = format_char_at(record.format, record.format_in_flash, i + j);
+    spec_str[spec.length] = '\0';
+    i += spec.length - 1;
+    int star_values[2];
+    for (uint8_t s = 0; s < spec.stars; s++)
+      star_values[s] = get_binary_arg<int>(args);
+    switch (spec.type) {
+      case LogArgType::NONE:
+        this->write_to_buffer_('%');
+        break;
+      case LogArgType::INT:
+        this->format_binary_arg_(spec_str, spec.stars, star_values, get_binary_arg<int>(args));
+        break;
+      case LogArgType::LONG:
+        this->format_binary_arg_(spec_str, spec.stars, star_values, get_binary_arg<long>(args));  // NOLINT
+        break;
+      case LogArgType::LONG_LONG:
+        this->format_binary_arg_(spec_str, spec.stars, star_values, get_binary_arg<long long>(args));  // NOLINT
+        break;
+      case LogArgType::SIZE:
+        this->format_binary_arg_(spec_str, spec.stars, star_values, get_binary_arg<size_t>(args));
+        break;
+      case LogArgType::DOUBLE:
+        this->format_binary_arg_(spec_str, spec.stars, star_values, get_binary_arg<double>(args));
+        break;
+      case LogArgType::LONG_DOUBLE:
+        this->format_binary_arg_(spec_str, spec.stars, star_values, get_binary_arg<long double>(args));
+        break;
+      case LogArgType::STRING: {
+        auto *str = reinterpret_cast<const char *>(args);
+        this->format_binary_arg_(spec_str, spec.stars, star_values, str);
+        args += strlen(str) + 1;
+        break;
+      }
+      case LogArgType::POINTER:
+        this->format_binary_arg_(spec_str, spec.stars, star_values, get_binary_arg<const void *>(args));
+        break;
+      case LogArgType::UNSUPPORTED:
+        // never captured
+        break;
+    }
+  }
+  this->write_footer_();
+  this->log_message_(record.level, record.tag);
+}
+#endif
+
 int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
+  if (this->tag_levels_ == nullptr)
+    return this->default_level_;
+
+  // TAGs are string constants, so the pointer identifies the tag and the comparison only runs once per pointer
+  uint32_t slot = (uint32_t(reinterpret_cast<uintptr_t>(tag)) * 2654435761UL) >> (32 - TAG_LEVEL_SLOT_BITS);
+  for (uint8_t i = 0; i < TAG_LEVEL_SLOTS; i++) {
+    TagLevelSlot &entry = this->tag_levels_[(slot + i) & (TAG_LEVEL_SLOTS - 1)];
+    if (entry.tag == tag)
+      return entry.level;
+    if (entry.tag == nullptr) {
+      entry.level = this->lookup_level_(tag);
+      entry.tag = tag;
+      return entry.level;
+    }
+  }
+  // more distinct tags than slots
+  return this->lookup_level_(tag);
+}
+int Logger::lookup_level_(const char *tag) const {
   for (auto &it : this->log_levels_) {
     if (it.tag == tag) {
       return it.level;
     }
   }
-  return ESPHOME_LOG_LEVEL;
+  return this->default_level_;
 }
 void HOT Logger::log_message_(int level, const char *tag, int offset) {
   // remove trailing newline
@@ -167,7 +559,23 @@ void Logger::pre_setup() {
 }
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 void Logger::set_log_level(const std::string &tag, int log_level) {
-  this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  log_level = std::max(ESPHOME_LOG_LEVEL_NONE, std::min(log_level, ESPHOME_LOG_LEVEL_VERY_VERBOSE));
+  if (tag.empty()) {
+    this->default_level_ = std::min(log_level, ESPHOME_LOG_LEVEL);
+  } else {
+    auto it = std::find_if(this->log_levels_.begin(), this->log_levels_.end(),
+                           [&tag](const LogLevelOverride &level) { return level.tag == tag; });
+    if (it != this->log_levels_.end())
+      it->level = log_level;
+    else
+      this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  }
+
+  // resolved levels are cached per TAG pointer, start over
+  if (this->tag_levels_ == nullptr)
+    this->tag_levels_ = new TagLevelSlot[TAG_LEVEL_SLOTS];
+  for (uint8_t i = 0; i < TAG_LEVEL_SLOTS; i++)
+    this->tag_levels_[i].tag = nullptr;
 }
 UARTSelection Logger::get_uart() const { return this->uart_; }
 void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
@@ -183,12 +591,15 @@ const char *UART_SELECTIONS[] = {"UART0", "UART1", "UART0_SWAP"};
 #endif
 void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "Logger:");
-  ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
+  ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[this->default_level_]);
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %u", this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
+#ifdef USE_LOGGER_BINARY_LOG
+  ESP_LOGCONFIG(TAG, "  Binary Log Buffer Size: %u", this->binary_capacity_);
+#endif
 }
 void Logger::write_footer_() { this->write_to_buffer_(ESPHOME_LOG_RESET_COLOR, strlen(ESPHOME_LOG_RESET_COLOR)); }
 
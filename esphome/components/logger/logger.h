@@ -37,9 +37,22 @@ class Logger : public Component {
   /// Get the UART used by the logger.
   UARTSelection get_uart() const;
 
-  /// Set the log level of the specified tag.
+  /** Set the log level of the specified tag, can be changed at runtime.
+   *
+   * An empty tag sets the level of all tags without an override. Levels more verbose than the
+   * compile-time level have no effect, those log calls are not part of the firmware.
+   */
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef USE_LOGGER_BINARY_LOG
+  /** Capture log calls in binary form into a ring buffer of this size and format them in loop().
+   *
+   * The call site only copies the format pointer and the raw arguments, errors are still written immediately.
+   */
+  void set_binary_log_buffer_size(size_t size);
+  void loop() override;
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
@@ -63,6 +76,48 @@ class Logger : public Component {
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
 
+#ifdef USE_LOGGER_BINARY_LOG
+  /// Header of a captured log call, followed by the arguments in the order of the format string.
+  struct BinaryLogRecord {
+    /// Total size including this header, 0 marks the end of the used part of the ring.
+    uint16_t size;
+    uint8_t level;
+    bool format_in_flash;
+    uint16_t line;
+    const char *tag;
+    const char *format;
+  };
+
+  /// Returns false if the call has to be formatted right away instead.
+  bool capture_binary_(int level, const char *tag, int line, const char *format, bool format_in_flash,
+                       va_list args);  // NOLINT
+  uint8_t *reserve_binary_(size_t size);
+  void commit_binary_(uint8_t *record, size_t size);
+  /// Format and output up to max_records captured calls, oldest first.
+  void drain_binary_(uint32_t max_records);
+  void format_binary_(const BinaryLogRecord &record, const uint8_t *args);
+  template<typename T> void format_binary_arg_(const char *spec, uint8_t stars, const int *star_values, T value) {
+    if (stars == 0)
+      this->printf_to_buffer_(spec, value);
+    else if (stars == 1)
+      this->printf_to_buffer_(spec, star_values[0], value);
+    else
+      this->printf_to_buffer_(spec, star_values[0], star_values[1], value);
+  }
+
+  uint8_t *binary_buffer_{nullptr};
+  size_t binary_capacity_{0};
+  /// Offset of the next record to capture.
+  volatile size_t binary_head_{0};
+  /// Offset of the next record to format, the ring is empty when it equals binary_head_.
+  volatile size_t binary_tail_{0};
+  /// Set while records are formatted, log calls from the log callbacks must not drain the ring again.
+  bool binary_draining_{false};
+#ifdef ARDUINO_ARCH_ESP32
+  TaskHandle_t binary_log_task_{nullptr};
+#endif
+#endif
+
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
   inline void reset_buffer_() { this->tx_buffer_at_ = 0; }
@@ -107,11 +162,22 @@ class Logger : public Component {
   int tx_buffer_size_{0};
   UARTSelection uart_{UART_SELECTION_UART0};
   HardwareSerial *hw_serial_{nullptr};
+  int lookup_level_(const char *tag) const;
+
   struct LogLevelOverride {
     std::string tag;
     int level;
   };
   std::vector<LogLevelOverride> log_levels_;
+  int default_level_{ESPHOME_LOG_LEVEL};
+  /// Resolved level per TAG pointer, only allocated once levels are overridden.
+  struct TagLevelSlot {
+    const char *tag;
+    int8_t level;
+  };
+  static const uint8_t TAG_LEVEL_SLOT_BITS = 6;
+  static const uint8_t TAG_LEVEL_SLOTS = 1 << TAG_LEVEL_SLOT_BITS;
+  TagLevelSlot *tag_levels_{nullptr};
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
 };
 
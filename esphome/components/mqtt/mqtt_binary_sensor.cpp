@@ -26,13 +26,13 @@ MQTTBinarySensorComponent::MQTTBinarySensorComponent(binary_sensor::BinarySensor
 }
 std::string MQTTBinarySensorComponent::friendly_name() const { return this->binary_sensor_->get_name(); }
 
-void MQTTBinarySensorComponent::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
+void MQTTBinarySensorComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
   if (!this->binary_sensor_->get_device_class().empty())
-    root["device_class"] = this->binary_sensor_->get_device_class();
+    root.add("device_class", this->binary_sensor_->get_device_class());
   if (this->binary_sensor_->is_status_binary_sensor())
-    root["payload_on"] = mqtt::global_mqtt_client->get_availability().payload_available;
+    root.add("payload_on", mqtt::global_mqtt_client->get_availability().payload_available);
   if (this->binary_sensor_->is_status_binary_sensor())
-    root["payload_off"] = mqtt::global_mqtt_client->get_availability().payload_not_available;
+    root.add("payload_off", mqtt::global_mqtt_client->get_availability().payload_not_available);
   config.command_topic = false;
 }
 bool MQTTBinarySensorComponent::send_initial_state() {
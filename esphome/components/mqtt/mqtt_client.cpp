@@ -15,6 +15,11 @@ namespace mqtt {
 
 static const char *TAG = "mqtt";
 
+/// Length of a discovery time window in ms.
+static const uint32_t DISCOVERY_WINDOW = 32;
+/// Maximum number of components to send discovery and initial state for per window.
+static const uint8_t DISCOVERY_COMPONENTS_PER_WINDOW = 8;
+
 MQTTClientComponent::MQTTClientComponent() {
   global_mqtt_client = this;
   this->credentials_.client_id = App.get_name() + "-" + get_mac_address();
@@ -33,7 +38,14 @@ void MQTTClientComponent::setup() {
 
     // MQTT fully received
     if (len + index == total) {
+#ifdef ARDUINO_ARCH_ESP8266
+      // hand the payload over to the queue without copying it, payload_buffer_ gets a previously delivered buffer
+      MQTTMessage &message = this->queue_message_();
+      message.topic.assign(topic);
+      message.payload.swap(this->payload_buffer_);
+#else
       this->on_message(topic, this->payload_buffer_);
+#endif
       this->payload_buffer_.clear();
     }
   });
@@ -213,11 +225,20 @@ void MQTTClientComponent::check_connected() {
 
   this->resubscribe_subscriptions_();
 
-  for (MQTTComponent *component : this->children_)
-    component->schedule_resend_state();
+  // discovery and initial states are sent from loop(), spread over a few windows
+  this->discovery_next_ = 0;
+  this->discovery_retry_.clear();
+  this->discovery_window_sent_ = 0;
+  this->discovery_duration_ = 0;
+  this->connected_at_ = millis();
+  this->discovery_window_start_ = this->connected_at_;
 }
 
 void MQTTClientComponent::loop() {
+#ifdef ARDUINO_ARCH_ESP8266
+  this->deliver_queued_messages_();
+#endif
+
   if (this->disconnect_reason_.has_value()) {
     const char *reason_s = nullptr;
     switch (*this->disconnect_reason_) {
@@ -282,6 +303,7 @@ void MQTTClientComponent::loop() {
 
         this->last_connected_ = now;
         this->resubscribe_subscriptions_();
+        this->send_pending_discovery_(now);
       }
       break;
   }
@@ -338,6 +360,7 @@ void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t ca
   };
   this->resubscribe_subscription_(&subscription);
   this->subscriptions_.push_back(subscription);
+  this->subscriptions_changed_ = true;
 }
 
 void MQTTClientComponent::subscribe_json(const std::string &topic, mqtt_json_callback_t callback, uint8_t qos) {
@@ -353,6 +376,7 @@ void MQTTClientComponent::subscribe_json(const std::string &topic, mqtt_json_cal
   };
   this->resubscribe_subscription_(&subscription);
   this->subscriptions_.push_back(subscription);
+  this->subscriptions_changed_ = true;
 }
 
 void MQTTClientComponent::unsubscribe(const std::string &topic) {
@@ -373,6 +397,7 @@ void MQTTClientComponent::unsubscribe(const std::string &topic) {
     else
       ++it;
   }
+  this->subscriptions_changed_ = true;
 }
 
 // Publish
@@ -417,82 +442,97 @@ bool MQTTClientComponent::publish_json(const std::string &topic, const json::jso
   return this->publish(topic, message, len, qos, retain);
 }
 
-/** Check if the message topic matches the given subscription topic
- *
- * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
- */
-static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
-
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
-
-  bool do_wildcards = is_normal || past_separator;
-
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
-    }
-    // after this, both pointers will point to a '/' or to the end of the string
+void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
+#ifdef ARDUINO_ARCH_ESP8266
+  // on ESP8266, this is called in LWiP thread; some components do not like running
+  // in an ISR.
+  MQTTMessage &message = this->queue_message_();
+  message.topic = topic;
+  message.payload = payload;
+#else
+  this->dispatch_message_(topic, payload);
+#endif
+}
 
-    return topic_match(message, subscription, is_normal, true);
+void MQTTClientComponent::dispatch_message_(const std::string &topic, const std::string &payload) {
+  if (this->subscriptions_changed_) {
+    // on ESP32 this runs in the async_tcp task, clear the flag first so a subscription added by the main loop while
+    // the trie is being rebuilt triggers another rebuild instead of being lost
+    this->subscriptions_changed_ = false;
+    this->subscription_trie_.clear();
+    for (size_t i = 0; i < this->subscriptions_.size(); i++)
+      this->subscription_trie_.insert(this->subscriptions_[i].topic, i);
   }
 
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
+  this->matching_subscriptions_.clear();
+  this->subscription_trie_.match(topic, &this->matching_subscriptions_);
+  for (uint16_t index : this->matching_subscriptions_) {
+    this->subscriptions_[index].callback(topic, payload);
+    // a callback (un)subscribed, the remaining indices may be stale
+    if (this->subscriptions_changed_)
+      break;
   }
-
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
-    return false;
-
-  past_separator = past_separator || *subscription == '/';
-
-  // consume characters
-  subscription++;
-  message++;
-
-  return topic_match(message, subscription, is_normal, past_separator);
 }
 
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+#ifdef ARDUINO_ARCH_ESP8266
+MQTTMessage &MQTTClientComponent::queue_message_() {
+  if (this->queued_messages_count_ == this->queued_messages_.size())
+    this->queued_messages_.emplace_back();
+  return this->queued_messages_[this->queued_messages_count_++];
 }
 
-void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
-#ifdef ARDUINO_ARCH_ESP8266
-  // on ESP8266, this is called in LWiP thread; some components do not like running
-  // in an ISR.
-  this->defer([this, topic, payload]() {
-#endif
-    for (auto &subscription : this->subscriptions_)
-      if (topic_match(topic.c_str(), subscription.topic.c_str()))
-        subscription.callback(topic, payload);
-#ifdef ARDUINO_ARCH_ESP8266
-  });
-#endif
+void MQTTClientComponent::deliver_queued_messages_() {
+  if (this->queued_messages_count_ == 0)
+    return;
+  // callbacks may yield to the LwIP thread, which then queues into the other pool
+  std::swap(this->queued_messages_, this->delivered_messages_);
+  const size_t count = this->queued_messages_count_;
+  this->queued_messages_count_ = 0;
+  for (size_t i = 0; i < count; i++)
+    this->dispatch_message_(this->delivered_messages_[i].topic, this->delivered_messages_[i].payload);
 }
+#endif
 
 // Setters
 void MQTTClientComponent::disable_log_message() { this->log_message_.topic = ""; }
 bool MQTTClientComponent::is_log_message_enabled() const { return !this->log_message_.topic.empty(); }
 void MQTTClientComponent::set_reboot_timeout(uint32_t reboot_timeout) { this->reboot_timeout_ = reboot_timeout; }
 void MQTTClientComponent::register_mqtt_component(MQTTComponent *component) { this->children_.push_back(component); }
+void MQTTClientComponent::send_pending_discovery_(uint32_t now) {
+  if (this->discovery_next_ >= this->children_.size() && this->discovery_retry_.empty())
+    return;
+
+  if (now - this->discovery_window_start_ >= DISCOVERY_WINDOW) {
+    this->discovery_window_start_ = now;
+    this->discovery_window_sent_ = 0;
+  }
+  while (this->discovery_window_sent_ < DISCOVERY_COMPONENTS_PER_WINDOW) {
+    MQTTComponent *component;
+    if (this->discovery_next_ < this->children_.size()) {
+      component = this->children_[this->discovery_next_++];
+    } else if (!this->discovery_retry_.empty()) {
+      component = this->discovery_retry_.front();
+      this->discovery_retry_.erase(this->discovery_retry_.begin());
+    } else {
+      break;
+    }
+    this->discovery_window_sent_++;
+    if (!component->send_discovery_and_initial_state()) {
+      // retry it after the others so a payload that can't be sent doesn't hold them back,
+      // and stop for now as the outbound queue is probably full, it has drained a bit by the next loop
+      this->discovery_retry_.push_back(component);
+      return;
+    }
+  }
+
+  if (this->discovery_next_ == this->children_.size() && this->discovery_retry_.empty() &&
+      this->discovery_duration_ == 0) {
+    this->discovery_duration_ = std::max<uint32_t>(millis() - this->connected_at_, 1);
+    ESP_LOGI(TAG, "Sent discovery and state for %u components %u ms after connecting",
+             static_cast<unsigned>(this->children_.size()), this->discovery_duration_);
+  }
+}
+uint32_t MQTTClientComponent::get_discovery_duration() const { return this->discovery_duration_; }
 void MQTTClientComponent::set_log_level(int level) { this->log_level_ = level; }
 void MQTTClientComponent::set_keep_alive(uint16_t keep_alive_s) { this->mqtt_client_.setKeepAlive(keep_alive_s); }
 void MQTTClientComponent::set_log_message_template(MQTTMessage &&message) { this->log_message_ = std::move(message); }
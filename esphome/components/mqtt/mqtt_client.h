@@ -5,6 +5,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/log.h"
 #include "esphome/components/json/json_util.h"
+#include "mqtt_subscription_trie.h"
 #include <AsyncMqttClient.h>
 #include "lwip/ip_addr.h"
 
@@ -213,6 +214,10 @@ class MQTTClientComponent : public Component {
 
   bool is_connected();
 
+  /// Time from the last (re)connect until discovery and initial states were sent for all components, in ms.
+  /// 0 while that is still in progress.
+  uint32_t get_discovery_duration() const;
+
   void on_shutdown() override;
 
   void set_broker_address(const std::string &address) { this->credentials_.address = address; }
@@ -238,6 +243,14 @@ class MQTTClientComponent : public Component {
   bool subscribe_(const char *topic, uint8_t qos);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
+  /// Call the callbacks of all subscriptions matching the topic.
+  void dispatch_message_(const std::string &topic, const std::string &payload);
+#ifdef ARDUINO_ARCH_ESP8266
+  MQTTMessage &queue_message_();
+  void deliver_queued_messages_();
+#endif
+  /// Send discovery and initial states for the next components, a few per time window so the outbound queue can drain.
+  void send_pending_discovery_(uint32_t now);
 
   MQTTCredentials credentials_;
   /// The last will message. Disabled optional denotes it being default and
@@ -263,12 +276,31 @@ class MQTTClientComponent : public Component {
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  MQTTSubscriptionTrie subscription_trie_;
+  /// Whether subscriptions_ changed since subscription_trie_ was built.
+  volatile bool subscriptions_changed_{true};
+  std::vector<uint16_t> matching_subscriptions_;
+#ifdef ARDUINO_ARCH_ESP8266
+  /// Messages received in the LwIP thread, delivered from loop(). Both pools keep their strings (and capacity) between
+  /// messages, new messages are queued into one while the other is being delivered.
+  std::vector<MQTTMessage> queued_messages_;
+  size_t queued_messages_count_{0};
+  std::vector<MQTTMessage> delivered_messages_;
+#endif
   AsyncMqttClient mqtt_client_;
   MQTTClientState state_{MQTT_CLIENT_DISCONNECTED};
   IPAddress ip_;
   bool dns_resolved_{false};
   bool dns_resolve_error_{false};
   std::vector<MQTTComponent *> children_;
+  /// Index of the next child to send discovery and the initial state for since connecting.
+  size_t discovery_next_{0};
+  /// Components whose discovery couldn't be published, retried after all others.
+  std::vector<MQTTComponent *> discovery_retry_;
+  uint32_t discovery_window_start_{0};
+  uint8_t discovery_window_sent_{0};
+  uint32_t connected_at_{0};
+  uint32_t discovery_duration_{0};
   uint32_t reboot_timeout_{300000};
   uint32_t connect_begin_;
   uint32_t last_connected_{0};
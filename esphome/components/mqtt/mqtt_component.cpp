@@ -56,9 +56,9 @@ bool MQTTComponent::send_discovery_() {
 
   ESP_LOGV(TAG, "'%s': Sending discovery...", this->friendly_name().c_str());
 
-  return global_mqtt_client->publish_json(
-      this->get_discovery_topic_(discovery_info),
-      [this](JsonObject &root) {
+  size_t length;
+  const char *payload = json::write_json(
+      [this](json::JsonWriter &root) {
         SendDiscoveryConfig config;
         config.state_topic = true;
         config.command_topic = true;
@@ -66,48 +66,51 @@ bool MQTTComponent::send_discovery_() {
         this->send_discovery(root, config);
 
         std::string name = this->friendly_name();
-        root["name"] = name;
+        root.add("name", name);
         if (config.state_topic)
-          root["state_topic"] = this->get_state_topic_();
+          root.add("state_topic", this->get_state_topic_());
         if (config.command_topic)
-          root["command_topic"] = this->get_command_topic_();
+          root.add("command_topic", this->get_command_topic_());
 
         if (this->availability_ == nullptr) {
           if (!global_mqtt_client->get_availability().topic.empty()) {
-            root["availability_topic"] = global_mqtt_client->get_availability().topic;
+            root.add("availability_topic", global_mqtt_client->get_availability().topic);
             if (global_mqtt_client->get_availability().payload_available != "online")
-              root["payload_available"] = global_mqtt_client->get_availability().payload_available;
+              root.add("payload_available", global_mqtt_client->get_availability().payload_available);
             if (global_mqtt_client->get_availability().payload_not_available != "offline")
-              root["payload_not_available"] = global_mqtt_client->get_availability().payload_not_available;
+              root.add("payload_not_available", global_mqtt_client->get_availability().payload_not_available);
           }
         } else if (!this->availability_->topic.empty()) {
-          root["availability_topic"] = this->availability_->topic;
+          root.add("availability_topic", this->availability_->topic);
           if (this->availability_->payload_available != "online")
-            root["payload_available"] = this->availability_->payload_available;
+            root.add("payload_available", this->availability_->payload_available);
           if (this->availability_->payload_not_available != "offline")
-            root["payload_not_available"] = this->availability_->payload_not_available;
+            root.add("payload_not_available", this->availability_->payload_not_available);
         }
 
         const std::string &node_name = App.get_name();
         std::string unique_id = this->unique_id();
         if (!unique_id.empty()) {
-          root["unique_id"] = unique_id;
+          root.add("unique_id", unique_id);
         } else {
           // default to almost-unique ID. It's a hack but the only way to get that
           // gorgeous device registry view.
-          root["unique_id"] = "ESP" + this->component_type() + this->get_default_object_id_();
+          root.add("unique_id", "ESP" + this->component_type() + this->get_default_object_id_());
         }
 
-        JsonObject &device_info = root.createNestedObject("device");
-        device_info["identifiers"] = get_mac_address();
-        device_info["name"] = node_name;
-        device_info["sw_version"] = "esphome v" ESPHOME_VERSION " " + App.get_compilation_time();
+        root.begin_object("device");
+        root.add("identifiers", get_mac_address());
+        root.add("name", node_name);
+        root.add("sw_version", "esphome v" ESPHOME_VERSION " " + App.get_compilation_time());
 #ifdef ARDUINO_BOARD
-        device_info["model"] = ARDUINO_BOARD;
+        root.add("model", ARDUINO_BOARD);
 #endif
-        device_info["manufacturer"] = "espressif";
+        root.add("manufacturer", "espressif");
+        root.end_object();
       },
-      0, discovery_info.retain);
+      &length);
+  return global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), payload, length, 0,
+                                     discovery_info.retain);
 }
 
 bool MQTTComponent::get_retain() const { return this->retain_; }
@@ -154,19 +157,8 @@ void MQTTComponent::call_setup() {
 
   this->setup();
 
+  // the client sends discovery and the initial state once it's connected
   global_mqtt_client->register_mqtt_component(this);
-
-  if (!this->is_connected_())
-    return;
-
-  if (this->is_discovery_enabled()) {
-    if (!this->send_discovery_()) {
-      this->schedule_resend_state();
-    }
-  }
-  if (!this->send_initial_state()) {
-    this->schedule_resend_state();
-  }
 }
 
 void MQTTComponent::call_loop() {
@@ -180,14 +172,18 @@ void MQTTComponent::call_loop() {
   }
 
   this->resend_state_ = false;
-  if (this->is_discovery_enabled()) {
-    if (!this->send_discovery_()) {
-      this->schedule_resend_state();
-    }
+  if (!this->send_initial_state()) {
+    this->schedule_resend_state();
   }
+}
+bool MQTTComponent::send_discovery_and_initial_state() {
+  if (this->is_discovery_enabled() && !this->send_discovery_())
+    return false;
+  this->resend_state_ = false;
   if (!this->send_initial_state()) {
     this->schedule_resend_state();
   }
+  return true;
 }
 void MQTTComponent::schedule_resend_state() { this->resend_state_ = true; }
 std::string MQTTComponent::unique_id() { return ""; }
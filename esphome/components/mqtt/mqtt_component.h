@@ -42,7 +42,7 @@ struct SendDiscoveryConfig {
  *
  * In order to implement automatic Home Assistant discovery, all sub-classes should:
  *
- *  1. Implement send_discovery that creates a Home Assistant discovery payload.
+ *  1. Implement send_discovery that writes the Home Assistant discovery payload members.
  *  2. Override component_type() to return the appropriate component type such as "light" or "sensor".
  *  3. Subscribe to command topics using subscribe() or subscribe_json() during setup().
  *
@@ -60,8 +60,12 @@ class MQTTComponent : public Component {
 
   void call_loop() override;
 
-  /// Send discovery info the Home Assistant, override this.
-  virtual void send_discovery(JsonObject &root, SendDiscoveryConfig &config) = 0;
+  /** Send discovery info the Home Assistant, override this.
+   *
+   * The members are streamed into the payload, so every key must only be written once and this may be called
+   * twice for one discovery message; it must write the same output both times.
+   */
+  virtual void send_discovery(json::JsonWriter &root, SendDiscoveryConfig &config) = 0;
 
   virtual bool send_initial_state() = 0;
 
@@ -93,9 +97,13 @@ class MQTTComponent : public Component {
   void set_availability(std::string topic, std::string payload_available, std::string payload_not_available);
   void disable_availability();
 
-  /// Internal method for the MQTT client base to schedule a resend of the state on reconnect.
+  /// Internal method to schedule a resend of the state, for example after publishing it failed.
   void schedule_resend_state();
 
+  /// Internal method for the MQTT client to send discovery info (if enabled) and the initial state after connecting.
+  /// Returns false if the discovery info couldn't be published and this has to be retried.
+  bool send_discovery_and_initial_state();
+
   /** Send a MQTT message.
    *
    * @param topic The topic.
@@ -28,23 +28,24 @@ bool MQTTJSONLightComponent::publish_state_() {
 }
 LightState *MQTTJSONLightComponent::get_state() const { return this->state_; }
 std::string MQTTJSONLightComponent::friendly_name() const { return this->state_->get_name(); }
-void MQTTJSONLightComponent::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
-  root["schema"] = "json";
+void MQTTJSONLightComponent::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
+  root.add("schema", "json");
   auto traits = this->state_->get_traits();
   if (traits.get_supports_brightness())
-    root["brightness"] = true;
+    root.add("brightness", true);
   if (traits.get_supports_rgb())
-    root["rgb"] = true;
+    root.add("rgb", true);
   if (traits.get_supports_color_temperature())
-    root["color_temp"] = true;
+    root.add("color_temp", true);
   if (traits.get_supports_rgb_white_value())
-    root["white_value"] = true;
+    root.add("white_value", true);
   if (this->state_->supports_effects()) {
-    root["effect"] = true;
-    JsonArray &effect_list = root.createNestedArray("effect_list");
+    root.add("effect", true);
+    root.begin_array("effect_list");
     for (auto *effect : this->state_->get_effects())
-      effect_list.add(effect->get_name());
-    effect_list.add("None");
+      root.add(effect->get_name());
+    root.add("None");
+    root.end_array();
   }
 }
 bool MQTTJSONLightComponent::send_initial_state() { return this->publish_state_(); }
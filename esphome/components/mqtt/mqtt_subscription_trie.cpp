@@ -0,0 +1,185 @@
+#include "mqtt_subscription_trie.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace mqtt {
+
+/** Check if the message topic matches the given subscription topic
+ *
+ * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
+ *
+ * @param message The message topic that was received from the MQTT server. Note: this must not contain
+ *                wildcard characters as mandated by the MQTT spec.
+ * @param subscription The subscription topic we are matching against.
+ * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
+ * @param past_separator Are we past the first '/' topic separator.
+ * @return true if the subscription topic matches the message topic, false otherwise.
+ */
+static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
+  // Reached end of both strings at the same time, this means we have a successful match
+  if (*message == '\0' && *subscription == '\0')
+    return true;
+
+  // Either the message or the subscribe are at the end. This means they don't match.
+  if (*message == '\0' || *subscription == '\0')
+    return false;
+
+  bool do_wildcards = is_normal || past_separator;
+
+  if (*subscription == '+' && do_wildcards) {
+    // single level wildcard
+    // consume + from subscription
+    subscription++;
+    // consume everything from message until '/' found or end of string
+    while (*message != '\0' && *message != '/') {
+      message++;
+    }
+    // after this, both pointers will point to a '/' or to the end of the string
+
+    return topic_match(message, subscription, is_normal, true);
+  }
+
+  if (*subscription == '#' && do_wildcards) {
+    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
+    return true;
+  }
+
+  // this handles '/' and normal characters at the same time.
+  if (*message != *subscription)
+    return false;
+
+  past_separator = past_separator || *subscription == '/';
+
+  // consume characters
+  subscription++;
+  message++;
+
+  return topic_match(message, subscription, is_normal, past_separator);
+}
+
+static bool topic_match(const char *message, const char *subscription) {
+  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+}
+
+MQTTSubscriptionTrie::MQTTSubscriptionTrie() { this->clear(); }
+
+void MQTTSubscriptionTrie::clear() {
+  this->nodes_.clear();
+  this->nodes_.emplace_back();
+  this->unindexed_.clear();
+}
+
+void MQTTSubscriptionTrie::insert(const std::string &topic, uint16_t index) {
+  uint32_t node = 0;
+  size_t start = 0;
+  while (true) {
+    size_t end = topic.find('/', start);
+    if (end == std::string::npos)
+      end = topic.size();
+    std::string level = topic.substr(start, end - start);
+
+    if (level == "#") {
+      // matches the rest of the topic, anything after it is ignored like in topic_match
+      this->nodes_[node].multi_level.push_back(index);
+      return;
+    }
+    if (level == "+") {
+      if (this->nodes_[node].plus == 0) {
+        this->nodes_.emplace_back();
+        this->nodes_[node].plus = this->nodes_.size() - 1;
+      }
+      node = this->nodes_[node].plus;
+    } else if (level.find_first_of("+#") != std::string::npos) {
+      // wildcards inside a level have no node of their own, keep the character by character behavior for them
+      this->unindexed_.emplace_back(topic, index);
+      return;
+    } else {
+      node = this->get_or_create_child_(node, level);
+    }
+
+    if (end == topic.size())
+      break;
+    start = end + 1;
+  }
+  this->nodes_[node].subscriptions.push_back(index);
+}
+
+void MQTTSubscriptionTrie::match(const std::string &topic, std::vector<uint16_t> *out) const {
+  const size_t first = out->size();
+  const char *begin = topic.c_str();
+  // wildcards do not match the first level of topics starting with '$'
+  this->match_(0, begin, begin + topic.size(), !topic.empty() && topic[0] != '$', out);
+  for (auto &entry : this->unindexed_) {
+    if (topic_match(begin, entry.first.c_str()))
+      out->push_back(entry.second);
+  }
+  std::sort(out->begin() + first, out->end());
+}
+
+uint32_t MQTTSubscriptionTrie::find_child_(const Node &node, const char *level, size_t len) const {
+  // binary search without constructing a string for the level
+  size_t lo = 0, hi = node.children.size();
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    int cmp = node.children[mid].first.compare(0, std::string::npos, level, len);
+    if (cmp == 0)
+      return node.children[mid].second;
+    if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return 0;
+}
+
+uint32_t MQTTSubscriptionTrie::get_or_create_child_(uint32_t node, const std::string &level) {
+  uint32_t child = this->find_child_(this->nodes_[node], level.data(), level.size());
+  if (child != 0)
+    return child;
+
+  child = this->nodes_.size();
+  this->nodes_.emplace_back();
+  auto &children = this->nodes_[node].children;
+  auto it = children.begin();
+  while (it != children.end() && it->first < level)
+    ++it;
+  children.insert(it, std::make_pair(level, child));
+  return child;
+}
+
+void MQTTSubscriptionTrie::match_(uint32_t node, const char *level, const char *end, bool wildcards,
+                                 std::vector<uint16_t> *out) const {
+  const Node &current = this->nodes_[node];
+  const char *level_end = static_cast<const char *>(memchr(level, '/', end - level));
+  if (level_end == nullptr)
+    level_end = end;
+  const bool last = level_end == end;
+
+  // wildcards need at least one character left in the topic
+  if (wildcards && level != end) {
+    out->insert(out->end(), current.multi_level.begin(), current.multi_level.end());
+    if (current.plus != 0) {
+      if (last) {
+        auto &plus = this->nodes_[current.plus].subscriptions;
+        out->insert(out->end(), plus.begin(), plus.end());
+      } else {
+        this->match_(current.plus, level_end + 1, end, true, out);
+      }
+    }
+  }
+
+  uint32_t child = this->find_child_(current, level, level_end - level);
+  if (child == 0)
+    return;
+  if (last) {
+    auto &subscriptions = this->nodes_[child].subscriptions;
+    out->insert(out->end(), subscriptions.begin(), subscriptions.end());
+  } else {
+    this->match_(child, level_end + 1, end, true, out);
+  }
+}
+
+}  // namespace mqtt
+}  // namespace esphome
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+namespace esphome {
+namespace mqtt {
+
+/** Index of subscription topics for matching received message topics.
+ *
+ * Every topic level is a node, with the '+' wildcard as a separate child and '#' stored on the node it follows,
+ * so a message topic is matched by walking its levels instead of comparing it with every subscription.
+ * Subscriptions are identified by their index, matches are returned in ascending index order.
+ */
+class MQTTSubscriptionTrie {
+ public:
+  MQTTSubscriptionTrie();
+
+  /// Remove all subscriptions.
+  void clear();
+  /// Add the subscription topic with the given index.
+  void insert(const std::string &topic, uint16_t index);
+  /// Append the indices of all subscriptions matching the message topic to out, in ascending order.
+  void match(const std::string &topic, std::vector<uint16_t> *out) const;
+
+ protected:
+  struct Node {
+    /// Children for literal topic levels, sorted by level.
+    std::vector<std::pair<std::string, uint32_t>> children;
+    /// Child for the '+' single level wildcard, 0 if there is none.
+    uint32_t plus{0};
+    /// Subscriptions whose topic ends at this node.
+    std::vector<uint16_t> subscriptions;
+    /// Subscriptions whose topic continues with the '#' multi level wildcard after this node.
+    std::vector<uint16_t> multi_level;
+  };
+
+  uint32_t find_child_(const Node &node, const char *level, size_t len) const;
+  uint32_t get_or_create_child_(uint32_t node, const std::string &level);
+  void match_(uint32_t node, const char *level, const char *end, bool wildcards, std::vector<uint16_t> *out) const;
+
+  /// All nodes, the root is at index 0 (so 0 can mean "no child").
+  std::vector<Node> nodes_;
+  /// Subscriptions using wildcard characters inside a topic level, matched character by character.
+  std::vector<std::pair<std::string, uint16_t>> unindexed_;
+};
+
+}  // namespace mqtt
+}  // namespace esphome
@@ -11,9 +11,9 @@ static const char *TAG = "mqtt.text_sensor";
 using namespace esphome::text_sensor;
 
 MQTTTextSensor::MQTTTextSensor(TextSensor *sensor) : MQTTComponent(), sensor_(sensor) {}
-void MQTTTextSensor::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
+void MQTTTextSensor::send_discovery(json::JsonWriter &root, mqtt::SendDiscoveryConfig &config) {
   if (!this->sensor_->get_icon().empty())
-    root["icon"] = this->sensor_->get_icon();
+    root.add("icon", this->sensor_->get_icon());
 
   config.command_topic = false;
 }
@@ -105,6 +105,16 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
   }
 
  protected:
+  light::ESPPixelSpan make_pixel_span_(uint8_t stride) const {
+    light::ESPPixelSpan span;
+    span.data = this->controller_->Pixels();
+    span.size = this->size();
+    span.stride = stride;
+    for (uint8_t i = 0; i < 4; i++)
+      span.offsets[i] = this->rgb_offsets_[i];
+    return span;
+  }
+
   NeoPixelBus<T_COLOR_FEATURE, T_METHOD> *controller_{nullptr};
   uint8_t *effect_data_{nullptr};
   uint8_t rgb_offsets_[4]{0, 1, 2, 3};
@@ -126,6 +136,7 @@ class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COL
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                nullptr, this->effect_data_ + index, &this->correction_);
   }
+  light::ESPPixelSpan get_pixel_span_internal() const override { return this->make_pixel_span_(3); }
 };
 
 template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbwFeature>
@@ -145,6 +156,7 @@ class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_CO
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                base + this->rgb_offsets_[3], this->effect_data_ + index, &this->correction_);
   }
+  light::ESPPixelSpan get_pixel_span_internal() const override { return this->make_pixel_span_(4); }
 };
 
 }  // namespace neopixelbus
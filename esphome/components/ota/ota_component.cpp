@@ -22,6 +22,8 @@ uint8_t OTA_VERSION_1_0 = 1;
 void OTAComponent::setup() {
   this->server_ = new WiFiServer(this->port_);
   this->server_->begin();
+  // handle_() runs a whole update once a client is accepted, polling for one about once per second is enough
+  this->set_loop_idle(true);
 
   this->dump_config();
 }
@@ -9,6 +9,7 @@ struct JVCData {
   uint32_t data;
 
   bool operator==(const JVCData &rhs) const { return data == rhs.data; }
+  uint32_t hash() const { return data; }
 };
 
 class JVCProtocol : public RemoteProtocol<JVCData> {
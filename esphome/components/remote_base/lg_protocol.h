@@ -11,6 +11,7 @@ struct LGData {
   uint8_t nbits;
 
   bool operator==(const LGData &rhs) const { return data == rhs.data && nbits == rhs.nbits; }
+  uint32_t hash() const { return data ^ (uint32_t(nbits) << 24); }
 };
 
 class LGProtocol : public RemoteProtocol<LGData> {
@@ -10,6 +10,7 @@ struct NECData {
   uint16_t command;
 
   bool operator==(const NECData &rhs) const { return address == rhs.address && command == rhs.command; }
+  uint32_t hash() const { return (uint32_t(address) << 16) | command; }
 };
 
 class NECProtocol : public RemoteProtocol<NECData> {
@@ -11,6 +11,7 @@ struct PanasonicData {
   uint32_t command;
 
   bool operator==(const PanasonicData &rhs) const { return address == rhs.address && command == rhs.command; }
+  uint32_t hash() const { return command ^ (uint32_t(address) << 16); }
 };
 
 class PanasonicProtocol : public RemoteProtocol<PanasonicData> {
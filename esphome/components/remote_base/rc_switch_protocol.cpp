@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "rc_switch_protocol.h"
 #include "esphome/core/log.h"
 
@@ -239,7 +240,51 @@ bool RCSwitchRawReceiver::matches(RemoteReceiveData src) {
   if (!this->protocol_.decode(src, &decoded_code, &decoded_nbits))
     return false;
 
-  return decoded_nbits == this->nbits_ && (decoded_code & this->mask_) == (this->code_ & this->mask_);
+  return this->matches_code(decoded_code, decoded_nbits);
+}
+bool RCSwitchRawReceiver::attach_decoder(RemoteReceiverBase *receiver) {
+  receiver->get_decoder<RCSwitchRawDecoder>()->add_receiver(this);
+  return true;
+}
+
+void RCSwitchRawDecoder::add_receiver(RCSwitchRawReceiver *receiver) {
+  auto it = std::find_if(this->groups_.begin(), this->groups_.end(),
+                         [receiver](const Group &group) { return group.protocol == receiver->get_protocol(); });
+  if (it == this->groups_.end()) {
+    this->groups_.emplace_back();
+    it = this->groups_.end() - 1;
+    it->protocol = receiver->get_protocol();
+  }
+  if (receiver->is_masked()) {
+    it->masked_receivers.push_back(receiver);
+  } else {
+    it->receivers.insert({receiver->get_code(), receiver});
+  }
+}
+bool RCSwitchRawDecoder::on_receive(RemoteReceiveData src) {
+  bool success = false;
+  for (auto &group : this->groups_) {
+    src.reset();
+    uint64_t decoded_code;
+    uint8_t decoded_nbits;
+    if (!group.protocol.decode(src, &decoded_code, &decoded_nbits))
+      continue;
+
+    auto range = group.receivers.equal_range(decoded_code);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->matches_code(decoded_code, decoded_nbits)) {
+        it->second->publish_match();
+        success = true;
+      }
+    }
+    for (auto *receiver : group.masked_receivers) {
+      if (receiver->matches_code(decoded_code, decoded_nbits)) {
+        receiver->publish_match();
+        success = true;
+      }
+    }
+  }
+  return success;
 }
 bool RCSwitchDumper::dump(RemoteReceiveData src) {
   for (uint8_t i = 1; i <= 8; i++) {
@@ -11,6 +11,7 @@ struct RCSwitchData {
   uint8_t protocol;
 
   bool operator==(const RCSwitchData &rhs) const { return code == rhs.code && protocol == rhs.protocol; }
+  uint32_t hash() const { return uint32_t(code) ^ uint32_t(code >> 32) ^ (uint32_t(protocol) << 24); }
 };
 
 class RCSwitchBase {
@@ -50,6 +51,12 @@ class RCSwitchBase {
 
   static void type_d_code(uint8_t group, uint8_t device, bool state, uint64_t *out_code, uint8_t *out_nbits);
 
+  bool operator==(const RCSwitchBase &rhs) const {
+    return sync_high_ == rhs.sync_high_ && sync_low_ == rhs.sync_low_ && zero_high_ == rhs.zero_high_ &&
+           zero_low_ == rhs.zero_low_ && one_high_ == rhs.one_high_ && one_low_ == rhs.one_low_ &&
+           inverted_ == rhs.inverted_;
+  }
+
  protected:
   uint32_t sync_high_{};
   uint32_t sync_low_{};
@@ -199,6 +206,18 @@ class RCSwitchRawReceiver : public RemoteReceiverBinarySensorBase {
     RCSwitchBase::type_d_code(u_group, device, state, &this->code_, &this->nbits_);
   }
 
+  bool attach_decoder(RemoteReceiverBase *receiver) override;
+  bool matches_code(uint64_t code, uint8_t nbits) const {
+    return nbits == this->nbits_ && (code & this->mask_) == (this->code_ & this->mask_);
+  }
+  const RCSwitchBase &get_protocol() const { return this->protocol_; }
+  uint64_t get_code() const { return this->code_; }
+  /// Whether any of the nbits bits of the code is an 'x' (don't care) bit.
+  bool is_masked() const {
+    const uint64_t all = this->nbits_ >= 64 ? UINT64_MAX : (1ULL << this->nbits_) - 1;
+    return (this->mask_ & all) != all;
+  }
+
  protected:
   bool matches(RemoteReceiveData src) override;
 
@@ -208,6 +227,24 @@ class RCSwitchRawReceiver : public RemoteReceiverBinarySensorBase {
   uint8_t nbits_;
 };
 
+/// Decodes each frame once per distinct protocol of the raw receivers and looks them up by the decoded code.
+class RCSwitchRawDecoder : public RemoteReceiverDecoderBase {
+ public:
+  void add_receiver(RCSwitchRawReceiver *receiver);
+  bool on_receive(RemoteReceiveData src) override;
+
+ protected:
+  struct Group {
+    RCSwitchBase protocol;
+    /// Receivers with a fully specified code, by that code.
+    std::unordered_multimap<uint64_t, RCSwitchRawReceiver *> receivers;
+    /// Receivers with 'x' (don't care) bits in their code.
+    std::vector<RCSwitchRawReceiver *> masked_receivers;
+  };
+
+  std::vector<Group> groups_;
+};
+
 class RCSwitchDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override;
@@ -1,4 +1,5 @@
 #include <utility>
+#include <unordered_map>
 
 #pragma once
 
@@ -208,9 +209,24 @@ class RemoteTransmitterBase : public RemoteComponentBase {
   RemoteTransmitData temp_;
 };
 
+class RemoteReceiverBase;
+
 class RemoteReceiverListener {
  public:
   virtual bool on_receive(RemoteReceiveData data) = 0;
+  /// Attach this listener to a shared decoder stage of the receiver instead of being called with every raw frame.
+  virtual bool attach_decoder(RemoteReceiverBase *receiver) { return false; }
+};
+
+/// A stage that decodes each received frame once and notifies all listeners attached to it.
+class RemoteReceiverDecoderBase : public RemoteReceiverListener {
+ public:
+  virtual ~RemoteReceiverDecoderBase() = default;
+  const void *get_type() const { return this->type_; }
+  void set_type(const void *type) { this->type_ = type; }
+
+ protected:
+  const void *type_{nullptr};
 };
 
 class RemoteReceiverDumperBase {
@@ -222,7 +238,10 @@ class RemoteReceiverDumperBase {
 class RemoteReceiverBase : public RemoteComponentBase {
  public:
   RemoteReceiverBase(GPIOPin *pin) : RemoteComponentBase(pin) {}
-  void register_listener(RemoteReceiverListener *listener) { this->listeners_.push_back(listener); }
+  void register_listener(RemoteReceiverListener *listener) {
+    this->listeners_.push_back(listener);
+    this->clear_stages_();
+  }
   void register_dumper(RemoteReceiverDumperBase *dumper) {
     if (dumper->is_secondary()) {
       this->secondary_dumpers_.push_back(dumper);
@@ -232,10 +251,49 @@ class RemoteReceiverBase : public RemoteComponentBase {
   }
   void set_tolerance(uint8_t tolerance) { tolerance_ = tolerance; }
 
+  /// Get the decoder stage of type Decoder shared by all listeners of one protocol, creating it on first use.
+  template<typename Decoder> Decoder *get_decoder() {
+    static const uint8_t TYPE = 0;
+    for (auto *decoder : this->decoders_) {
+      if (decoder->get_type() == &TYPE)
+        return static_cast<Decoder *>(decoder);
+    }
+    auto *decoder = new Decoder();  // NOLINT(cppcoreguidelines-owning-memory)
+    decoder->set_type(&TYPE);
+    this->decoders_.push_back(decoder);
+    return decoder;
+  }
+
  protected:
+  /** Group the listeners into decoder stages. Done on the first frame, after all listeners have been configured.
+   *
+   * A decoder stage runs at the position of the first listener attached to it, so its other listeners are notified
+   * earlier than before relative to the listeners registered in between. Within a stage, triggers are called before
+   * binary sensors.
+   */
+  void build_stages_() {
+    for (auto *listener : this->listeners_) {
+      size_t decoders = this->decoders_.size();
+      if (!listener->attach_decoder(this)) {
+        this->stages_.push_back(listener);
+      } else if (this->decoders_.size() != decoders) {
+        this->stages_.push_back(this->decoders_.back());
+      }
+    }
+    this->stages_built_ = true;
+  }
+  void clear_stages_() {
+    for (auto *decoder : this->decoders_)
+      delete decoder;  // NOLINT(cppcoreguidelines-owning-memory)
+    this->decoders_.clear();
+    this->stages_.clear();
+    this->stages_built_ = false;
+  }
   bool call_listeners_() {
+    if (!this->stages_built_)
+      this->build_stages_();
     bool success = false;
-    for (auto *listener : this->listeners_) {
+    for (auto *listener : this->stages_) {
       auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
       if (listener->on_receive(data))
         success = true;
@@ -264,6 +322,10 @@ class RemoteReceiverBase : public RemoteComponentBase {
   }
 
   std::vector<RemoteReceiverListener *> listeners_;
+  /// Decoder stages and the listeners that could not be attached to one, ordered by their first listener.
+  std::vector<RemoteReceiverListener *> stages_;
+  std::vector<RemoteReceiverDecoderBase *> decoders_;
+  bool stages_built_{false};
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
   std::vector<int32_t> temp_;
@@ -279,19 +341,58 @@ class RemoteReceiverBinarySensorBase : public binary_sensor::BinarySensorInitial
   virtual bool matches(RemoteReceiveData src) = 0;
   bool on_receive(RemoteReceiveData src) override {
     if (this->matches(src)) {
-      this->publish_state(true);
-      yield();
-      this->publish_state(false);
+      this->publish_match();
       return true;
     }
     return false;
   }
+  /// Publish a short ON pulse for a received code that matches this sensor.
+  void publish_match() {
+    this->publish_state(true);
+    yield();
+    this->publish_state(false);
+  }
+};
+
+/// Decodes each frame once with protocol T and looks up the binary sensors expecting the decoded payload by its hash.
+template<typename T, typename D> class RemoteReceiverDecoder : public RemoteReceiverDecoderBase {
+ public:
+  void add_binary_sensor(RemoteReceiverBinarySensorBase *binary_sensor, const D &data) {
+    this->binary_sensors_.insert({data.hash(), {data, binary_sensor}});
+  }
+  void add_trigger(Trigger<D> *trigger) { this->triggers_.push_back(trigger); }
+  bool on_receive(RemoteReceiveData src) override {
+    auto proto = T();
+    auto res = proto.decode(src);
+    if (!res.has_value())
+      return false;
+    for (auto *trigger : this->triggers_)
+      trigger->trigger(*res);
+    bool success = !this->triggers_.empty();
+    auto range = this->binary_sensors_.equal_range(res->hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.first == *res) {
+        it->second.second->publish_match();
+        success = true;
+      }
+    }
+    return success;
+  }
+
+ protected:
+  std::unordered_multimap<uint32_t, std::pair<D, RemoteReceiverBinarySensorBase *>> binary_sensors_;
+  std::vector<Trigger<D> *> triggers_;
 };
 
 template<typename T, typename D> class RemoteReceiverBinarySensor : public RemoteReceiverBinarySensorBase {
  public:
   RemoteReceiverBinarySensor() : RemoteReceiverBinarySensorBase() {}
 
+  bool attach_decoder(RemoteReceiverBase *receiver) override {
+    receiver->get_decoder<RemoteReceiverDecoder<T, D>>()->add_binary_sensor(this, this->data_);
+    return true;
+  }
+
  protected:
   bool matches(RemoteReceiveData src) override {
     auto proto = T();
@@ -307,6 +408,12 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 };
 
 template<typename T, typename D> class RemoteReceiverTrigger : public Trigger<D>, public RemoteReceiverListener {
+ public:
+  bool attach_decoder(RemoteReceiverBase *receiver) override {
+    receiver->get_decoder<RemoteReceiverDecoder<T, D>>()->add_trigger(this);
+    return true;
+  }
+
  protected:
   bool on_receive(RemoteReceiveData src) override {
     auto proto = T();
@@ -11,6 +11,7 @@ struct Samsung36Data {
   uint32_t command;
 
   bool operator==(const Samsung36Data &rhs) const { return address == rhs.address && command == rhs.command; }
+  uint32_t hash() const { return command ^ (uint32_t(address) << 16); }
 };
 
 class Samsung36Protocol : public RemoteProtocol<Samsung36Data> {
@@ -10,6 +10,7 @@ struct SamsungData {
   uint32_t data;
 
   bool operator==(const SamsungData &rhs) const { return data == rhs.data; }
+  uint32_t hash() const { return data; }
 };
 
 class SamsungProtocol : public RemoteProtocol<SamsungData> {
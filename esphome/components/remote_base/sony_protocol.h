@@ -11,6 +11,7 @@ struct SonyData {
   uint8_t nbits;
 
   bool operator==(const SonyData &rhs) const { return data == rhs.data && nbits == rhs.nbits; }
+  uint32_t hash() const { return data ^ (uint32_t(nbits) << 24); }
 };
 
 class SonyProtocol : public RemoteProtocol<SonyData> {
@@ -10,15 +10,21 @@ namespace remote_receiver {
 struct RemoteReceiverComponentStore {
   static void gpio_intr(RemoteReceiverComponentStore *arg);
 
-  /// Stores the time (in micros) that the leading/falling edge happened at
-  ///  * An even index means a falling edge appeared at the time stored at the index
-  ///  * An uneven index means a rising edge appeared at the time stored at the index
-  volatile uint32_t *buffer{nullptr};
-  /// The position last written to
-  volatile uint32_t buffer_write_at;
-  /// The position last read from
-  uint32_t buffer_read_at{0};
-  bool overflow{false};
+  /// Ring of delta-encoded edges, one 16-bit word per edge:
+  ///  * The upper bit is set if the edge ended a mark (a falling edge), unset if it ended a space
+  ///  * The lower 15 bits are the time (in micros) since the previous edge. If that does not fit, they are all set
+  ///    and the full 32-bit time follows in two more words, upper half first
+  volatile uint16_t *buffer{nullptr};
+  /// The position written to next
+  volatile uint32_t buffer_write_at{0};
+  /// The position read from next
+  volatile uint32_t buffer_read_at{0};
+  /// The time (in micros) of the last edge, also tracked while the buffer is full
+  volatile uint32_t last_edge{0};
+  /// The level after the last edge
+  bool last_level{false};
+  /// Set when an edge did not fit into the buffer, no edges are stored until the signal has been dropped
+  volatile bool overflow{false};
   uint32_t buffer_size{1000};
   uint8_t filter_us{10};
   ISRInternalGPIOPin *pin;
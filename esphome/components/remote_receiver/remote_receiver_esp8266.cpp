@@ -9,24 +9,59 @@ namespace remote_receiver {
 
 static const char *TAG = "remote_receiver.esp8266";
 
+static const uint16_t EDGE_MARK = 0x8000;
+static const uint16_t EDGE_DURATION_MASK = 0x7FFF;
+/// Durations of at least this many micros are stored as an escape word followed by the full 32-bit duration
+static const uint16_t EDGE_DURATION_ESCAPE = 0x7FFF;
+
 void ICACHE_RAM_ATTR HOT RemoteReceiverComponentStore::gpio_intr(RemoteReceiverComponentStore *arg) {
   const uint32_t now = micros();
-  // If the lhs is 1 (rising edge) we should write to an uneven index and vice versa
-  const uint32_t next = (arg->buffer_write_at + 1) % arg->buffer_size;
+  // Levels must alternate, a second edge to the same level means a short pulse was missed
   const bool level = arg->pin->digital_read();
-  if (level != next % 2)
+  if (level == arg->last_level)
     return;
 
-  // If next is buffer_read, we have hit an overflow
-  if (next == arg->buffer_read_at)
+  const uint32_t time_since_change = now - arg->last_edge;
+  if (time_since_change <= arg->filter_us)
     return;
 
-  const uint32_t last_change = arg->buffer[arg->buffer_write_at];
-  const uint32_t time_since_change = now - last_change;
-  if (time_since_change <= arg->filter_us)
+  arg->last_edge = now;
+  arg->last_level = level;
+  if (arg->overflow)
     return;
 
-  arg->buffer[arg->buffer_write_at = next] = now;
+  const uint32_t size = arg->buffer_size;
+  const uint32_t read_at = arg->buffer_read_at;
+  uint32_t write_at = arg->buffer_write_at;
+  // One slot is always kept free to tell a full buffer from an empty one
+  const uint32_t free = read_at > write_at ? read_at - write_at - 1 : size - write_at + read_at - 1;
+  const uint16_t mark = level ? 0 : EDGE_MARK;
+  volatile uint16_t *buffer = arg->buffer;
+
+  if (time_since_change < EDGE_DURATION_ESCAPE) {
+    if (free < 1) {
+      arg->overflow = true;
+      return;
+    }
+    buffer[write_at] = mark | time_since_change;
+    if (++write_at == size)
+      write_at = 0;
+  } else {
+    if (free < 3) {
+      arg->overflow = true;
+      return;
+    }
+    buffer[write_at] = mark | EDGE_DURATION_ESCAPE;
+    if (++write_at == size)
+      write_at = 0;
+    buffer[write_at] = time_since_change >> 16;
+    if (++write_at == size)
+      write_at = 0;
+    buffer[write_at] = time_since_change & 0xFFFF;
+    if (++write_at == size)
+      write_at = 0;
+  }
+  arg->buffer_write_at = write_at;
 }
 
 void RemoteReceiverComponent::setup() {
@@ -38,21 +73,17 @@ void RemoteReceiverComponent::setup() {
   s.buffer_size = this->buffer_size_;
 
   this->high_freq_.start();
-  if (s.buffer_size % 2 != 0) {
-    // Make sure divisible by two. This way, we know that every 0bxxx0 index is a space and every 0bxxx1 index is a mark
-    s.buffer_size++;
-  }
+  // The longest edge needs three words, the ring always keeps one free
+  if (s.buffer_size < 4)
+    s.buffer_size = 4;
 
-  s.buffer = new uint32_t[s.buffer_size];
+  s.buffer = new uint16_t[s.buffer_size];
   void *buf = (void *) s.buffer;
-  memset(buf, 0, s.buffer_size * sizeof(uint32_t));
+  memset(buf, 0, s.buffer_size * sizeof(uint16_t));
 
-  // First index is a space.
-  if (this->pin_->digital_read()) {
-    s.buffer_write_at = s.buffer_read_at = 1;
-  } else {
-    s.buffer_write_at = s.buffer_read_at = 0;
-  }
+  s.buffer_write_at = s.buffer_read_at = 0;
+  s.last_level = this->pin_->digital_read();
+  s.last_edge = micros();
   this->pin_->attach_interrupt(RemoteReceiverComponentStore::gpio_intr, &this->store_, CHANGE);
 }
 void RemoteReceiverComponent::dump_config() {
@@ -71,45 +102,73 @@ void RemoteReceiverComponent::dump_config() {
 void RemoteReceiverComponent::loop() {
   auto &s = this->store_;
 
-  // copy write at to local variables, as it's volatile
+  // copy write at to a local variable, as it's volatile
   const uint32_t write_at = s.buffer_write_at;
-  const uint32_t dist = (s.buffer_size + write_at - s.buffer_read_at) % s.buffer_size;
-  // signals must at least one rising and one leading edge
-  if (dist <= 1)
+  uint32_t read_at = s.buffer_read_at;
+  if (read_at == write_at && !s.overflow)
     return;
   const uint32_t now = micros();
-  if (now - s.buffer[write_at] < this->idle_us_)
+  if (now - s.last_edge < this->idle_us_)
     // The last change was fewer than the configured idle time ago.
     return;
 
-  ESP_LOGVV(TAG, "read_at=%u write_at=%u dist=%u now=%u end=%u", s.buffer_read_at, write_at, dist, now,
-            s.buffer[write_at]);
-
-  // Skip first value, it's from the previous idle level
-  s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
-  uint32_t prev = s.buffer_read_at;
-  s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
-  const uint32_t reserve_size = 1 + (s.buffer_size + write_at - s.buffer_read_at) % s.buffer_size;
-  this->temp_.clear();
-  this->temp_.reserve(reserve_size);
-  int32_t multiplier = s.buffer_read_at % 2 == 0 ? 1 : -1;
-
-  for (uint32_t i = 0; prev != write_at; i++) {
-    int32_t delta = s.buffer[s.buffer_read_at] - s.buffer[prev];
-    if (uint32_t(delta) >= this->idle_us_) {
-      // already found a space longer than idle. There must have been two pulses
-      break;
+  if (s.overflow) {
+    // The ISR stops writing on overflow, so everything up to write at is complete and can be dropped
+    s.buffer_read_at = s.buffer_write_at;
+    s.overflow = false;
+    ESP_LOGW(TAG, "Signal did not fit into the buffer and was dropped, try increasing buffer_size");
+    return;
+  }
+
+  const uint32_t size = s.buffer_size;
+  const volatile uint16_t *buffer = s.buffer;
+  uint32_t duration = 0;
+  bool mark = false;
+  auto read_edge = [&]() {
+    const uint16_t word = buffer[read_at];
+    if (++read_at == size)
+      read_at = 0;
+    mark = word & EDGE_MARK;
+    duration = word & EDGE_DURATION_MASK;
+    if (duration == EDGE_DURATION_ESCAPE) {
+      duration = uint32_t(buffer[read_at]) << 16;
+      if (++read_at == size)
+        read_at = 0;
+      duration |= buffer[read_at];
+      if (++read_at == size)
+        read_at = 0;
     }
+  };
 
-    ESP_LOGVV(TAG, "  i=%u buffer[%u]=%u - buffer[%u]=%u -> %d", i, s.buffer_read_at, s.buffer[s.buffer_read_at], prev,
-              s.buffer[prev], multiplier * delta);
-    this->temp_.push_back(multiplier * delta);
-    prev = s.buffer_read_at;
-    s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
-    multiplier *= -1;
+  // Skip first edge, its duration is the idle time before the signal
+  read_edge();
+  // signals must at least one rising and one leading edge
+  if (read_at == write_at)
+    return;
+  ESP_LOGVV(TAG, "read_at=%u write_at=%u now=%u end=%u", read_at, write_at, now, s.last_edge);
+
+  // Each remaining word holds at most one edge, plus one entry for the final idle period
+  const uint32_t max_len = (size + write_at - read_at) % size + 1;
+  if (this->temp_.size() < max_len)
+    this->temp_.resize(max_len);
+  int32_t *out = this->temp_.data();
+  uint32_t len = 0;
+  while (read_at != write_at) {
+    const uint32_t edge_at = read_at;
+    const bool prev_mark = mark;
+    read_edge();
+    if (duration >= this->idle_us_) {
+      // already found a space longer than idle. There must have been two pulses, leave this one for the next call
+      read_at = edge_at;
+      mark = prev_mark;
+      break;
+    }
+    out[len++] = mark ? int32_t(duration) : -int32_t(duration);
   }
-  s.buffer_read_at = (s.buffer_size + s.buffer_read_at - 1) % s.buffer_size;
-  this->temp_.push_back(this->idle_us_ * multiplier);
+  // The level after the last edge lasted at least the idle time
+  out[len++] = mark ? -int32_t(this->idle_us_) : int32_t(this->idle_us_);
+  this->temp_.resize(len);
+  s.buffer_read_at = read_at;
 
   this->call_listeners_dumpers_();
 }
@@ -118,6 +118,7 @@ void ICACHE_RAM_ATTR HOT RotaryEncoderSensorStore::gpio_intr(RotaryEncoderSensor
     } else {
       *std::prev(first_zero) += rotation_dir;  // store the rotation into the previous slot
     }
+    arg->parent->enable_loop_soon_any_context();
   }
 
   arg->state = new_state;
@@ -125,6 +126,7 @@ void ICACHE_RAM_ATTR HOT RotaryEncoderSensorStore::gpio_intr(RotaryEncoderSensor
 
 void RotaryEncoderSensor::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Rotary Encoder '%s'...", this->name_.c_str());
+  this->store_.parent = this;
   this->pin_a_->setup();
   this->store_.pin_a = this->pin_a_->to_isr();
   this->pin_b_->setup();
@@ -192,6 +194,10 @@ void RotaryEncoderSensor::loop() {
     this->store_.last_read = counter;
     this->publish_state(counter);
   }
+
+  // without a reset pin there's nothing to poll, the interrupt re-enables the loop on rotation
+  if (this->pin_i_ == nullptr)
+    this->disable_loop();
 }
 
 float RotaryEncoderSensor::get_setup_priority() const { return setup_priority::DATA; }
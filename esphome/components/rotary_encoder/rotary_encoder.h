@@ -19,6 +19,7 @@ enum RotaryEncoderResolution {
 };
 
 struct RotaryEncoderSensorStore {
+  Component *parent;
   ISRInternalGPIOPin *pin_a;
   ISRInternalGPIOPin *pin_b;
 
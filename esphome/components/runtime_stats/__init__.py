@@ -0,0 +1,34 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+from esphome.core import CORE, coroutine_with_priority
+
+CODEOWNERS = ["@esphome/core"]
+
+CONF_LOG_INTERVAL = "log_interval"
+
+runtime_stats_ns = cg.esphome_ns.namespace("runtime_stats")
+RuntimeStatsComponent = runtime_stats_ns.class_("RuntimeStatsComponent", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(RuntimeStatsComponent),
+        cv.Optional(CONF_LOG_INTERVAL, default="60s"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(min=cv.TimePeriod(seconds=1)),
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+@coroutine_with_priority(-1000.0)
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+    cg.add(var.set_log_interval(config[CONF_LOG_INTERVAL]))
+    cg.add_define("USE_RUNTIME_STATS")
+
+    # Label every component with its ID so the report can attribute time to it
+    for id_, obj in CORE.variables.items():
+        if id_.type is not None and id_.type.inherits_from(cg.Component):
+            cg.add(obj.set_component_source(id_.id))
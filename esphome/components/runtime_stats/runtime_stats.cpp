@@ -0,0 +1,167 @@
+#include "runtime_stats.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace runtime_stats {
+
+static const char *TAG = "runtime_stats";
+
+RuntimeStatsComponent *global_runtime_stats = nullptr;
+
+void RuntimeStats::record(uint32_t duration_us) {
+  this->count_++;
+  this->total_us_ += duration_us;
+  if (duration_us < this->min_us_)
+    this->min_us_ = duration_us;
+  if (duration_us > this->max_us_)
+    this->max_us_ = duration_us;
+
+  uint8_t bucket = 0;
+  while (duration_us != 0 && bucket < BUCKET_COUNT - 1) {
+    duration_us >>= 1;
+    bucket++;
+  }
+  this->buckets_[bucket]++;
+}
+void RuntimeStats::reset() {
+  this->count_ = 0;
+  this->total_us_ = 0;
+  this->min_us_ = UINT32_MAX;
+  this->max_us_ = 0;
+  for (auto &bucket : this->buckets_)
+    bucket = 0;
+}
+uint32_t RuntimeStats::get_avg_us() const {
+  if (this->count_ == 0)
+    return 0;
+  return this->total_us_ / this->count_;
+}
+uint32_t RuntimeStats::get_percentile_us(float percentile) const {
+  if (this->count_ == 0)
+    return 0;
+  // rank of the requested sample, rounded up
+  const uint32_t rank = std::max<uint32_t>(1, uint32_t(ceilf(this->count_ * percentile / 100.0f)));
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < BUCKET_COUNT; i++) {
+    seen += this->buckets_[i];
+    if (seen >= rank) {
+      if (i == BUCKET_COUNT - 1)
+        break;
+      const uint32_t upper = (1UL << i) - 1;
+      return std::min(upper, this->max_us_);
+    }
+  }
+  return this->max_us_;
+}
+
+RuntimeStatsComponent::RuntimeStatsComponent() { global_runtime_stats = this; }
+
+void RuntimeStatsComponent::setup() {
+  this->period_start_ = millis();
+  this->set_interval("report", this->log_interval_, [this]() { this->report_(); });
+}
+void RuntimeStatsComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Runtime Stats:");
+  ESP_LOGCONFIG(TAG, "  Log Interval: %.1fs", this->log_interval_ / 1000.0f);
+}
+float RuntimeStatsComponent::get_setup_priority() const { return setup_priority::HARDWARE; }
+
+void HOT RuntimeStatsComponent::record_component(Component *component, uint32_t duration_us) {
+  const size_t size = this->components_.size();
+  // loop order is stable, so the next component is almost always at the cursor
+  for (size_t i = 0; i < size; i++) {
+    size_t index = this->cursor_ + i;
+    if (index >= size)
+      index -= size;
+    auto &entry = this->components_[index];
+    if (entry.first == component) {
+      entry.second.record(duration_us);
+      this->cursor_ = index + 1 < size ? index + 1 : 0;
+      return;
+    }
+  }
+  this->components_.emplace_back(component, RuntimeStats{});
+  this->components_.back().second.record(duration_us);
+  this->cursor_ = 0;
+}
+void HOT RuntimeStatsComponent::record_scheduler(Component *component, uint32_t name_hash, const std::string &name,
+                                                 uint32_t duration_us) {
+  auto key = std::make_pair(component, name_hash);
+  auto it = this->scheduler_items_.find(key);
+  if (it == this->scheduler_items_.end()) {
+    SchedulerStats stats;
+    stats.name = component != nullptr ? component->get_component_source() : "<none>";
+    stats.name += '/';
+    stats.name += name.empty() ? "<anonymous>" : name;
+    it = this->scheduler_items_.emplace(key, std::move(stats)).first;
+  }
+  it->second.stats.record(duration_us);
+}
+
+void RuntimeStatsComponent::add_on_report_callback(std::function<void(const RuntimeStatsReport &)> &&callback) {
+  this->report_callback_.add(std::move(callback));
+}
+
+static RuntimeStatsEntry make_entry(const std::string &name, const RuntimeStats &stats) {
+  RuntimeStatsEntry entry;
+  entry.name = name;
+  entry.count = stats.get_count();
+  entry.min_us = stats.get_min_us();
+  entry.avg_us = stats.get_avg_us();
+  entry.max_us = stats.get_max_us();
+  entry.p99_us = stats.get_percentile_us(99.0f);
+  entry.total_us = stats.get_total_us();
+  return entry;
+}
+static void sort_entries(std::vector<RuntimeStatsEntry> &entries) {
+  std::sort(entries.begin(), entries.end(),
+            [](const RuntimeStatsEntry &a, const RuntimeStatsEntry &b) { return a.total_us > b.total_us; });
+}
+static void log_entries(const char *title, const std::vector<RuntimeStatsEntry> &entries, uint32_t period_ms) {
+  ESP_LOGI(TAG, "%s:", title);
+  for (auto &entry : entries) {
+    // share of the period spent in this entry
+    const float load = period_ms == 0 ? 0.0f : entry.total_us / (period_ms * 10.0f);
+    ESP_LOGI(TAG, "  %s: count=%u min=%uus avg=%uus max=%uus p99=%uus total=%.1fms (%.2f%%)", entry.name.c_str(),
+             entry.count, entry.min_us, entry.avg_us, entry.max_us, entry.p99_us, entry.total_us / 1000.0f, load);
+  }
+}
+
+void RuntimeStatsComponent::report_() {
+  const uint32_t now = millis();
+  RuntimeStatsReport report;
+  report.period_ms = now - this->period_start_;
+
+  report.components.reserve(this->components_.size());
+  for (auto &entry : this->components_) {
+    if (entry.second.get_count() == 0)
+      continue;
+    report.components.push_back(make_entry(entry.first->get_component_source(), entry.second));
+  }
+  sort_entries(report.components);
+
+  report.scheduler_items.reserve(this->scheduler_items_.size());
+  for (auto &entry : this->scheduler_items_) {
+    if (entry.second.stats.get_count() == 0)
+      continue;
+    report.scheduler_items.push_back(make_entry(entry.second.name, entry.second.stats));
+  }
+  sort_entries(report.scheduler_items);
+
+  ESP_LOGI(TAG, "Runtime stats over the last %.1fs:", report.period_ms / 1000.0f);
+  log_entries("Components", report.components, report.period_ms);
+  log_entries("Scheduler", report.scheduler_items, report.period_ms);
+
+  this->report_callback_.call(report);
+
+  for (auto &entry : this->components_)
+    entry.second.reset();
+  for (auto &entry : this->scheduler_items_)
+    entry.second.stats.reset();
+  this->period_start_ = now;
+}
+
+}  // namespace runtime_stats
+}  // namespace esphome
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace runtime_stats {
+
+/** Execution time statistics of a single component or scheduler item.
+ *
+ * Keeps min/max/total in µs and a log2 histogram to estimate percentiles without storing samples.
+ */
+class RuntimeStats {
+ public:
+  /// Bucket i counts samples in [2^(i-1), 2^i) µs, the last bucket also holds everything above.
+  static const uint8_t BUCKET_COUNT = 24;
+
+  void record(uint32_t duration_us);
+  void reset();
+
+  uint32_t get_count() const { return this->count_; }
+  uint64_t get_total_us() const { return this->total_us_; }
+  uint32_t get_min_us() const { return this->count_ == 0 ? 0 : this->min_us_; }
+  uint32_t get_max_us() const { return this->max_us_; }
+  uint32_t get_avg_us() const;
+  /// Upper bound of the histogram bucket containing the given percentile (0-100), clamped to the maximum.
+  uint32_t get_percentile_us(float percentile) const;
+
+ protected:
+  uint32_t count_{0};
+  uint64_t total_us_{0};
+  uint32_t min_us_{UINT32_MAX};
+  uint32_t max_us_{0};
+  uint32_t buckets_[BUCKET_COUNT]{};
+};
+
+struct RuntimeStatsEntry {
+  std::string name;
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t avg_us;
+  uint32_t max_us;
+  uint32_t p99_us;
+  uint64_t total_us;
+};
+
+struct RuntimeStatsReport {
+  /// Length of the measurement period in ms.
+  uint32_t period_ms;
+  /// Per-component loop() statistics, sorted by total time descending.
+  std::vector<RuntimeStatsEntry> components;
+  /// Per timeout/interval statistics, sorted by total time descending.
+  std::vector<RuntimeStatsEntry> scheduler_items;
+};
+
+class RuntimeStatsComponent : public Component {
+ public:
+  RuntimeStatsComponent();
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+  void set_log_interval(uint32_t log_interval) { this->log_interval_ = log_interval; }
+
+  /// Record the duration of one loop() call of the given component.
+  void record_component(Component *component, uint32_t duration_us);
+  /// Record the duration of one scheduler callback of the given component.
+  void record_scheduler(Component *component, uint32_t name_hash, const std::string &name, uint32_t duration_us);
+
+  /// Called with every periodic report, right before the statistics are reset.
+  void add_on_report_callback(std::function<void(const RuntimeStatsReport &)> &&callback);
+
+ protected:
+  void report_();
+
+  struct SchedulerStats {
+    std::string name;
+    RuntimeStats stats;
+  };
+
+  uint32_t log_interval_{60000};
+  uint32_t period_start_{0};
+  /// Component stats in loop order, looked up starting at cursor_ so the common case is O(1).
+  std::vector<std::pair<Component *, RuntimeStats>> components_;
+  size_t cursor_{0};
+  std::map<std::pair<Component *, uint32_t>, SchedulerStats> scheduler_items_;
+  CallbackManager<void(const RuntimeStatsReport &)> report_callback_;
+};
+
+extern RuntimeStatsComponent *global_runtime_stats;
+
+}  // namespace runtime_stats
+}  // namespace esphome
@@ -24,6 +24,7 @@ from esphome.const import (
     CONF_SEND_FIRST_AT,
     CONF_TO,
     CONF_TRIGGER_ID,
+    CONF_TYPE_ID,
     CONF_UNIT_OF_MEASUREMENT,
     CONF_WINDOW_SIZE,
     CONF_NAME,
@@ -118,7 +119,8 @@ SensorPublishAction = sensor_ns.class_("SensorPublishAction", automation.Action)
 
 # Filters
 Filter = sensor_ns.class_("Filter")
-MedianFilter = sensor_ns.class_("MedianFilter", Filter)
+QuantileFilter = sensor_ns.class_("QuantileFilter", Filter)
+MedianFilter = sensor_ns.class_("MedianFilter", QuantileFilter)
 MinFilter = sensor_ns.class_("MinFilter", Filter)
 MaxFilter = sensor_ns.class_("MaxFilter", Filter)
 SlidingWindowMovingAverageFilter = sensor_ns.class_(
@@ -139,6 +141,11 @@ OrFilter = sensor_ns.class_("OrFilter", Filter)
 CalibrateLinearFilter = sensor_ns.class_("CalibrateLinearFilter", Filter)
 CalibratePolynomialFilter = sensor_ns.class_("CalibratePolynomialFilter", Filter)
 SensorInRangeCondition = sensor_ns.class_("SensorInRangeCondition", Filter)
+FusedFilter = sensor_ns.class_("FusedFilter", Filter)
+# filters that output values later instead of returning them from new_value() can't be fused
+UNFUSABLE_FILTERS = (DebounceFilter, HeartbeatFilter, OrFilter)
+
+CONF_FUSE_FILTERS = "fuse_filters"
 
 unit_of_measurement = cv.string_strict
 accuracy_decimals = cv.int_
@@ -159,6 +166,7 @@ SENSOR_SCHEMA = cv.MQTT_COMPONENT_SCHEMA.extend(
             cv.Any(None, cv.positive_time_period_milliseconds),
         ),
         cv.Optional(CONF_FILTERS): validate_filters,
+        cv.Optional(CONF_FUSE_FILTERS, default=False): cv.boolean,
         cv.Optional(CONF_ON_VALUE): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(SensorStateTrigger),
@@ -250,6 +258,32 @@ def median_filter_to_code(config, filter_id):
     )
 
 
+CONF_QUANTILE = "quantile"
+
+QUANTILE_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
+            cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
+            cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
+            cv.Optional(CONF_QUANTILE, default=0.9): cv.zero_to_one_float,
+        }
+    ),
+    validate_send_first_at,
+)
+
+
+@FILTER_REGISTRY.register("quantile", QuantileFilter, QUANTILE_SCHEMA)
+def quantile_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(
+        filter_id,
+        config[CONF_WINDOW_SIZE],
+        config[CONF_SEND_EVERY],
+        config[CONF_SEND_FIRST_AT],
+        config[CONF_QUANTILE],
+    )
+
+
 MIN_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -446,6 +480,29 @@ def build_filters(config):
     yield cg.build_registry_list(FILTER_REGISTRY, config)
 
 
+def fuse_filters(config, filters):
+    """Replace runs of consecutive filters by a single FusedFilter stage."""
+    fused = []
+    run = []
+
+    def flush():
+        if len(run) > 1:
+            types = [conf[CONF_TYPE_ID].type for conf, _ in run]
+            fused.append(FusedFilter.template(*types).new(*[var for _, var in run]))
+        else:
+            fused.extend(var for _, var in run)
+        del run[:]
+
+    for conf, var in zip(config, filters):
+        if conf[CONF_TYPE_ID].type in UNFUSABLE_FILTERS:
+            flush()
+            fused.append(var)
+        else:
+            run.append((conf, var))
+    flush()
+    return fused
+
+
 @coroutine
 def setup_sensor_core_(var, config):
     cg.add(var.set_name(config[CONF_NAME]))
@@ -462,6 +519,8 @@ def setup_sensor_core_(var, config):
     cg.add(var.set_force_update(config[CONF_FORCE_UPDATE]))
     if config.get(CONF_FILTERS):  # must exist and not be empty
         filters = yield build_filters(config[CONF_FILTERS])
+        if config[CONF_FUSE_FILTERS]:
+            filters = fuse_filters(config[CONF_FILTERS], filters)
         cg.add(var.set_filters(filters))
 
     for conf in config.get(CONF_ON_VALUE, []):
@@ -39,55 +39,190 @@ uint32_t Filter::calculate_remaining_interval(uint32_t input) {
   }
 }
 
-// MedianFilter
-MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MedianFilter::new_value(float value) {
-  if (!isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
+// SlidingWindowQuantile
+SlidingWindowQuantile::SlidingWindowQuantile(size_t window_size, float quantile) : quantile_(quantile) {
+  this->set_window_size(window_size);
+}
+void SlidingWindowQuantile::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->values_.reset(new float[window_size]);
+  this->heaps_.reset(new size_t[window_size]);
+  this->positions_.reset(new size_t[window_size]);
+  this->count_ = 0;
+  this->oldest_ = 0;
+  this->heap_size_[0] = this->heap_size_[1] = 0;
+}
+void SlidingWindowQuantile::set_quantile(float quantile) {
+  this->quantile_ = quantile;
+  if (this->count_ != 0)
+    this->rebalance_();
+}
+void SlidingWindowQuantile::push(float value) {
+  if (this->count_ == this->window_size_) {
+    // replace the oldest value where it is, the heap sizes stay the same
+    const size_t slot = this->oldest_;
+    this->oldest_ = this->wrap_(this->oldest_ + 1);
+    this->values_[slot] = value;
+    const bool upper = this->positions_[slot] >= this->window_size_;
+    const size_t index = this->positions_[slot] - (upper ? this->window_size_ : 0);
+    this->sift_up_(upper, index);
+    this->sift_down_(upper, index);
+    if (this->heap_size_[0] == 0 || this->heap_size_[1] == 0)
+      return;
+    // the new value may belong to the other heap, then swapping the two tops restores the order
+    const size_t lower_top = this->heap_at_(false, 0);
+    const size_t upper_top = this->heap_at_(true, 0);
+    if (this->values_[lower_top] > this->values_[upper_top]) {
+      this->heap_place_(false, 0, upper_top);
+      this->heap_place_(true, 0, lower_top);
+      this->sift_down_(false, 0);
+      this->sift_down_(true, 0);
     }
-    this->queue_.push_back(value);
-    ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
+    return;
+  }
+
+  const size_t slot = this->wrap_(this->oldest_ + this->count_);
+  this->values_[slot] = value;
+  // everything in the lower heap is less or equal to everything in the upper one
+  const bool upper = this->heap_size_[0] == 0 || value > this->values_[this->heap_at_(false, 0)];
+  this->heap_push_(upper, slot);
+  this->count_++;
+  this->rebalance_();
+}
+float SlidingWindowQuantile::get() const {
+  const float position = this->quantile_ * (this->count_ - 1);
+  const float fraction = position - floorf(position);
+  const float low = this->values_[this->heap_at_(false, 0)];
+  if (fraction == 0.0f || this->heap_size_[1] == 0)
+    return low;
+  const float high = this->values_[this->heap_at_(true, 0)];
+  if (fraction == 0.5f)
+    return (low + high) / 2.0f;
+  return low + (high - low) * fraction;
+}
+void SlidingWindowQuantile::rebalance_() {
+  // the lower heap holds every value up to and including the one at floor(position)
+  const size_t target = size_t(this->quantile_ * (this->count_ - 1)) + 1;
+  while (this->heap_size_[0] > target) {
+    const size_t slot = this->heap_at_(false, 0);
+    this->heap_remove_(slot);
+    this->heap_push_(true, slot);
+  }
+  while (this->heap_size_[0] < target) {
+    const size_t slot = this->heap_at_(true, 0);
+    this->heap_remove_(slot);
+    this->heap_push_(false, slot);
+  }
+}
+size_t &SlidingWindowQuantile::heap_at_(bool upper, size_t index) const {
+  return this->heaps_[upper ? this->window_size_ - 1 - index : index];
+}
+void SlidingWindowQuantile::heap_place_(bool upper, size_t index, size_t slot) {
+  this->heap_at_(upper, index) = slot;
+  this->positions_[slot] = upper ? this->window_size_ + index : index;
+}
+void SlidingWindowQuantile::heap_push_(bool upper, size_t slot) {
+  const size_t index = this->heap_size_[upper]++;
+  this->heap_place_(upper, index, slot);
+  this->sift_up_(upper, index);
+}
+void SlidingWindowQuantile::heap_remove_(size_t slot) {
+  const bool upper = this->positions_[slot] >= this->window_size_;
+  const size_t index = this->positions_[slot] - (upper ? this->window_size_ : 0);
+  const size_t last = --this->heap_size_[upper];
+  if (index == last)
+    return;
+  this->heap_place_(upper, index, this->heap_at_(upper, last));
+  // the moved slot goes either up or down, the other sift does nothing
+  this->sift_up_(upper, index);
+  this->sift_down_(upper, index);
+}
+void SlidingWindowQuantile::sift_up_(bool upper, size_t index) {
+  const size_t slot = this->heap_at_(upper, index);
+  while (index > 0) {
+    const size_t parent = (index - 1) / 2;
+    const size_t parent_slot = this->heap_at_(upper, parent);
+    if (!this->heap_before_(upper, slot, parent_slot))
+      break;
+    this->heap_place_(upper, index, parent_slot);
+    index = parent;
+  }
+  this->heap_place_(upper, index, slot);
+}
+void SlidingWindowQuantile::sift_down_(bool upper, size_t index) {
+  const size_t size = this->heap_size_[upper];
+  const size_t slot = this->heap_at_(upper, index);
+  while (true) {
+    size_t child = index * 2 + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && this->heap_before_(upper, this->heap_at_(upper, child + 1), this->heap_at_(upper, child)))
+      child++;
+    const size_t child_slot = this->heap_at_(upper, child);
+    if (!this->heap_before_(upper, child_slot, slot))
+      break;
+    this->heap_place_(upper, index, child_slot);
+    index = child;
+  }
+  this->heap_place_(upper, index, slot);
+}
+
+// SlidingWindowExtremum
+SlidingWindowExtremum::SlidingWindowExtremum(size_t window_size, bool maximum)
+    : maximum_(maximum), queue_(window_size) {}
+void SlidingWindowExtremum::push(float value) {
+  if (!this->queue_.empty() && this->pushed_ - this->queue_.front().age >= this->queue_.capacity())
+    this->queue_.pop_front();
+  // values that are worse than the new one can't become the extremum anymore. Equal ones stay, so that like
+  // min_element() the oldest of them is returned.
+  while (!this->queue_.empty()) {
+    const float back = this->queue_.back().value;
+    if (this->maximum_ ? back >= value : back <= value)
+      break;
+    this->queue_.pop_back();
+  }
+  this->queue_.push_back(Entry{value, this->pushed_++});
+}
+
+// QuantileFilter
+QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
+    : window_(window_size, quantile), send_every_(send_every), send_at_(send_every - send_first_at) {}
+void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
+void QuantileFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
+void QuantileFilter::set_quantile(float quantile) { this->window_.set_quantile(quantile); }
+optional<float> QuantileFilter::new_value(float value) {
+  if (!isnan(value)) {
+    this->window_.push(value);
+    ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f)", this, value);
   }
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float median = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> median_queue = this->queue_;
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size % 2) {
-        median = median_queue[queue_size / 2];
-      } else {
-        median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-      }
-    }
+    float result = 0.0f;
+    if (this->window_.size() != 0)
+      result = this->window_.get();
 
-    ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f) SENDING", this, median);
-    return median;
+    ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING", this, result);
+    return result;
   }
   return {};
 }
 
-uint32_t MedianFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
+uint32_t QuantileFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
+
+// MedianFilter
+MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
+    : QuantileFilter(window_size, send_every, send_first_at, 0.5f) {}
 
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size, false), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MinFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MinFilter::new_value(float value) {
   if (!isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -95,10 +230,8 @@ optional<float> MinFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float min = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::min_element(queue_.begin(), queue_.end());
-      min = *it;
-    }
+    if (!this->window_.empty())
+      min = this->window_.get();
 
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING", this, min);
     return min;
@@ -110,15 +243,12 @@ uint32_t MinFilter::expected_interval(uint32_t input) { return input * this->sen
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size, true), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MaxFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MaxFilter::new_value(float value) {
   if (!isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -126,10 +256,8 @@ optional<float> MaxFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float max = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float>::iterator it = std::max_element(queue_.begin(), queue_.end());
-      max = *it;
-    }
+    if (!this->window_.empty())
+      max = this->window_.get();
 
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING", this, max);
     return max;
@@ -142,13 +270,16 @@ uint32_t MaxFilter::expected_interval(uint32_t input) { return input * this->sen
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : queue_(window_size), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) {
+  this->queue_.set_capacity(window_size);
+  this->sum_ = 0.0f;
+}
 optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
   if (!isnan(value)) {
-    if (this->queue_.size() == this->window_size_) {
-      this->sum_ -= this->queue_[0];
+    if (this->queue_.full()) {
+      this->sum_ -= this->queue_.front();
       this->queue_.pop_front();
     }
     this->queue_.push_back(value);
@@ -165,8 +296,8 @@ optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
     if (this->send_at_ >= 10000) {
       // Recalculate to prevent floating point error accumulating
       this->sum_ = 0;
-      for (auto v : this->queue_)
-        this->sum_ += v;
+      for (size_t i = 0; i < this->queue_.size(); i++)
+        this->sum_ += this->queue_[i];
       average = this->sum_ / this->queue_.size();
       this->send_at_ = 0;
     }
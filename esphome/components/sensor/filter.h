@@ -1,6 +1,9 @@
 #pragma once
 
+#include <memory>
 #include <queue>
+#include <tuple>
+#include <type_traits>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 
@@ -46,34 +49,178 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
-/** Simple median filter.
+/** Fixed capacity double ended queue for the windowed filters.
  *
- * Takes the median of the last <send_every> values and pushes it out every <send_every>.
+ * The storage is allocated once with the window size from the configuration, so pushing values never touches the
+ * heap, unlike a std::deque that allocates and frees chunks as the window slides.
  */
-class MedianFilter : public Filter {
+template<typename T> class RingBuffer {
  public:
-  /** Construct a MedianFilter.
+  explicit RingBuffer(size_t capacity) { this->set_capacity(capacity); }
+
+  /// Reallocate the storage, this drops all items.
+  void set_capacity(size_t capacity) {
+    this->items_.reset(new T[capacity]);
+    this->capacity_ = capacity;
+    this->clear();
+  }
+  void clear() {
+    this->head_ = 0;
+    this->size_ = 0;
+  }
+
+  size_t capacity() const { return this->capacity_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  bool full() const { return this->size_ == this->capacity_; }
+
+  /// Item i counted from the oldest one.
+  T &operator[](size_t i) { return this->items_[this->wrap_(this->head_ + i)]; }
+  const T &operator[](size_t i) const { return this->items_[this->wrap_(this->head_ + i)]; }
+  T &front() { return this->items_[this->head_]; }
+  T &back() { return (*this)[this->size_ - 1]; }
+
+  /// Append an item, the buffer must not be full.
+  void push_back(const T &item) { this->items_[this->wrap_(this->head_ + this->size_++)] = item; }
+  void pop_front() {
+    this->head_ = this->wrap_(this->head_ + 1);
+    this->size_--;
+  }
+  void pop_back() { this->size_--; }
+
+ protected:
+  /// Index for a position below twice the capacity, cheaper than a modulo.
+  size_t wrap_(size_t index) const { return index >= this->capacity_ ? index - this->capacity_ : index; }
+
+  std::unique_ptr<T[]> items_;
+  size_t capacity_;
+  size_t head_;
+  size_t size_;
+};
+
+/** Sliding window of the last values that can tell a quantile of them in O(log n) per value.
+ *
+ * Values are kept in a ring buffer allocated once. The ring slots are split between two indexed binary heaps, a
+ * max-heap with the values up to the quantile and a min-heap with the ones above it, so the two values around the
+ * quantile are always at the heap tops.
+ */
+class SlidingWindowQuantile {
+ public:
+  SlidingWindowQuantile(size_t window_size, float quantile);
+
+  /// Add a value, dropping the oldest one when the window is full.
+  void push(float value);
+  /// The quantile of the values in the window, linearly interpolated between the closest two. Must not be empty.
+  float get() const;
+  size_t size() const { return this->count_; }
+
+  /// Resize the window, this drops all values.
+  void set_window_size(size_t window_size);
+  void set_quantile(float quantile);
+
+ protected:
+  /// Ring slot for an index below twice the window size, cheaper than a modulo.
+  size_t wrap_(size_t index) const { return index >= this->window_size_ ? index - this->window_size_ : index; }
+  size_t &heap_at_(bool upper, size_t index) const;
+  void heap_place_(bool upper, size_t index, size_t slot);
+  void heap_push_(bool upper, size_t slot);
+  void heap_remove_(size_t slot);
+  void sift_up_(bool upper, size_t index);
+  void sift_down_(bool upper, size_t index);
+  /// Whether slot a should be closer to the top of the heap than slot b.
+  bool heap_before_(bool upper, size_t a, size_t b) const {
+    return upper ? this->values_[a] < this->values_[b] : this->values_[a] > this->values_[b];
+  }
+  void rebalance_();
+
+  float quantile_;
+  size_t window_size_{0};
+  size_t count_{0};
+  /// Ring slot of the oldest value.
+  size_t oldest_{0};
+  std::unique_ptr<float[]> values_;
+  /// Both heaps share one array of ring slots, the lower heap grows from the start and the upper one from the end.
+  std::unique_ptr<size_t[]> heaps_;
+  size_t heap_size_[2]{0, 0};
+  /// Index of every ring slot in its heap, offset by window_size for the upper heap.
+  std::unique_ptr<size_t[]> positions_;
+};
+
+/** Sliding window of the last values that can tell their minimum or maximum in amortized O(1) per value.
+ *
+ * Keeps a monotonic queue in a ring buffer: only values that can still become the extremum before they leave the
+ * window are stored, so the oldest stored value is the current extremum.
+ */
+class SlidingWindowExtremum {
+ public:
+  SlidingWindowExtremum(size_t window_size, bool maximum);
+
+  /// Add a value, dropping the oldest one when the window is full.
+  void push(float value);
+  float get() const { return this->queue_[0].value; }
+  bool empty() const { return this->queue_.empty(); }
+
+  /// Resize the window, this drops all values.
+  void set_window_size(size_t window_size) { this->queue_.set_capacity(window_size); }
+
+ protected:
+  struct Entry {
+    float value;
+    /// Number of values pushed before this one, used to find values that left the window.
+    uint32_t age;
+  };
+
+  bool maximum_;
+  uint32_t pushed_{0};
+  RingBuffer<Entry> queue_;
+};
+
+/** Simple quantile filter.
+ *
+ * Takes the given quantile of the last <window_size> values and pushes it out every <send_every>.
+ */
+class QuantileFilter : public Filter {
+ public:
+  /** Construct a QuantileFilter.
    *
-   * @param window_size The number of values that should be used in median calculation.
+   * @param window_size The number of values that should be used in quantile calculation.
    * @param send_every After how many sensor values should a new one be pushed out.
    * @param send_first_at After how many values to forward the very first value. Defaults to the first value
    *   on startup being published on the first *raw* value, so with no filter applied. Must be less than or equal to
    *   send_every.
+   * @param quantile The quantile to push out, between 0 (minimum) and 1 (maximum).
    */
-  explicit MedianFilter(size_t window_size, size_t send_every, size_t send_first_at);
+  explicit QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile);
 
   optional<float> new_value(float value) override;
 
   void set_send_every(size_t send_every);
   void set_window_size(size_t window_size);
+  void set_quantile(float quantile);
 
   uint32_t expected_interval(uint32_t input) override;
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowQuantile window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
+};
+
+/** Simple median filter.
+ *
+ * Takes the median of the last <window_size> values and pushes it out every <send_every>.
+ */
+class MedianFilter : public QuantileFilter {
+ public:
+  /** Construct a MedianFilter.
+   *
+   * @param window_size The number of values that should be used in median calculation.
+   * @param send_every After how many sensor values should a new one be pushed out.
+   * @param send_first_at After how many values to forward the very first value. Defaults to the first value
+   *   on startup being published on the first *raw* value, so with no filter applied. Must be less than or equal to
+   *   send_every.
+   */
+  explicit MedianFilter(size_t window_size, size_t send_every, size_t send_first_at);
 };
 
 /** Simple min filter.
@@ -100,10 +247,9 @@ class MinFilter : public Filter {
   uint32_t expected_interval(uint32_t input) override;
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowExtremum window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple max filter.
@@ -130,10 +276,9 @@ class MaxFilter : public Filter {
   uint32_t expected_interval(uint32_t input) override;
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowExtremum window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -162,10 +307,9 @@ class SlidingWindowMovingAverageFilter : public Filter {
 
  protected:
   float sum_{0.0};
-  std::deque<float> queue_;
+  RingBuffer<float> queue_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple exponential moving average filter.
@@ -342,5 +486,59 @@ class CalibratePolynomialFilter : public Filter {
   std::vector<float> coefficients_;
 };
 
+/** A run of filters from the chain fused into one stage.
+ *
+ * The types of the stages are known at compile time, so each value goes through direct calls instead of the virtual
+ * input()/new_value()/output() hops between linked filters, and the compiler can inline across stages. Only filters
+ * that return their result from new_value() can be fused, the ones that output later (debounce, heartbeat, or)
+ * stay stages of their own.
+ */
+template<typename... Stages> class FusedFilter : public Filter {
+ public:
+  explicit FusedFilter(Stages *... stages) : stages_(stages...) {}
+
+  optional<float> new_value(float value) override { return this->run_<0>(value); }
+
+  void initialize(Sensor *parent, Filter *next) override {
+    Filter::initialize(parent, next);
+    this->initialize_stages_<0>(parent);
+  }
+
+  uint32_t expected_interval(uint32_t input) override { return this->expected_interval_<0>(input); }
+
+ protected:
+  template<size_t I> using Stage = typename std::tuple_element<I, std::tuple<Stages...>>::type;
+
+  template<size_t I> typename std::enable_if<(I < sizeof...(Stages)), optional<float>>::type run_(float value) {
+    using S = Stage<I>;
+    // qualified call, no virtual dispatch
+    optional<float> out = std::get<I>(this->stages_)->S::new_value(value);
+    if (!out.has_value())
+      return {};
+    return this->run_<I + 1>(*out);
+  }
+  template<size_t I> typename std::enable_if<(I == sizeof...(Stages)), optional<float>>::type run_(float value) {
+    return value;
+  }
+
+  template<size_t I> typename std::enable_if<(I < sizeof...(Stages))>::type initialize_stages_(Sensor *parent) {
+    // the stages hand their results back through new_value(), they have no next filter
+    std::get<I>(this->stages_)->initialize(parent, nullptr);
+    this->initialize_stages_<I + 1>(parent);
+  }
+  template<size_t I> typename std::enable_if<(I == sizeof...(Stages))>::type initialize_stages_(Sensor *parent) {}
+
+  template<size_t I>
+  typename std::enable_if<(I < sizeof...(Stages)), uint32_t>::type expected_interval_(uint32_t input) {
+    return this->expected_interval_<I + 1>(std::get<I>(this->stages_)->expected_interval(input));
+  }
+  template<size_t I>
+  typename std::enable_if<(I == sizeof...(Stages)), uint32_t>::type expected_interval_(uint32_t input) {
+    return input;
+  }
+
+  std::tuple<Stages *...> stages_;
+};
+
 }  // namespace sensor
 }  // namespace esphome
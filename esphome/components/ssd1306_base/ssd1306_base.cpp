@@ -91,6 +91,9 @@ void SSD1306::setup() {
 
   this->fill(BLACK);  // clear display - ensures we do not see garbage at power-on
   this->display();    // ...write buffer, which actually clears the display's memory
+  // one tile per page, the cleared buffer is what the display shows now
+  this->init_dirty_tiles_(1, this->get_width_internal(), 8);
+  this->get_dirty_regions_();
 
   this->turn_on();
 }
@@ -126,7 +129,9 @@ bool SSD1306::is_sh1106_() const {
 }
 void SSD1306::update() {
   this->do_update_();
-  this->display();
+  // the display keeps its contents, skip the transfer if nothing changed
+  if (!this->get_dirty_regions_().empty())
+    this->display();
 }
 void SSD1306::set_brightness(float brightness) {
   // validation
@@ -194,6 +199,39 @@ void HOT SSD1306::draw_absolute_pixel_internal(int x, int y, Color color) {
     this->buffer_[pos] &= ~(1 << subpos);
   }
 }
+void HOT SSD1306::fill_span_internal(int x, int y, int width, Color color) {
+  // a row is one bit in consecutive bytes of its page
+  uint8_t *dst = this->buffer_ + x + (y / 8) * this->get_width_internal();
+  const uint8_t mask = 1 << (y & 0x07);
+  if (color.is_on()) {
+    for (int i = 0; i < width; i++)
+      dst[i] |= mask;
+  } else {
+    for (int i = 0; i < width; i++)
+      dst[i] &= ~mask;
+  }
+}
+void HOT SSD1306::blit_row_internal(int x, int y, int width, const Color *colors) {
+  uint8_t *dst = this->buffer_ + x + (y / 8) * this->get_width_internal();
+  const uint8_t mask = 1 << (y & 0x07);
+  for (int i = 0; i < width; i++) {
+    if (colors[i].is_on()) {
+      dst[i] |= mask;
+    } else {
+      dst[i] &= ~mask;
+    }
+  }
+}
+uint32_t HOT SSD1306::checksum_tile_(int x, int y, int width, int height) {
+  // the buffer is organized in pages of eight rows with one byte per column
+  uint32_t hash = 2166136261UL;
+  for (int page = y / 8; page < (y + height + 7) / 8; page++) {
+    const uint8_t *data = this->buffer_ + page * this->get_width_internal();
+    for (int i = x; i < x + width; i++)
+      hash = (hash ^ data[i]) * 16777619UL;
+  }
+  return hash;
+}
 void SSD1306::fill(Color color) {
   uint8_t fill = color.is_on() ? 0xFF : 0x00;
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
@@ -45,6 +45,9 @@ class SSD1306 : public PollingComponent, public display::DisplayBuffer {
   bool is_sh1106_() const;
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_row_internal(int x, int y, int width, const Color *colors) override;
+  uint32_t checksum_tile_(int x, int y, int width, int height) override;
 
   int get_height_internal() override;
   int get_width_internal() override;
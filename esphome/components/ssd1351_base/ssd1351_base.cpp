@@ -157,6 +157,22 @@ void HOT SSD1351::draw_absolute_pixel_internal(int x, int y, Color color) {
   this->buffer_[pos++] = (color565 >> 8) & 0xff;
   this->buffer_[pos] = color565 & 0xff;
 }
+void HOT SSD1351::fill_span_internal(int x, int y, int width, Color color) {
+  const uint32_t color565 = display::ColorUtil::color_to_565(color);
+  uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * SSD1351_BYTESPERPIXEL;
+  for (int i = 0; i < width; i++) {
+    *dst++ = (color565 >> 8) & 0xff;
+    *dst++ = color565 & 0xff;
+  }
+}
+void HOT SSD1351::blit_row_internal(int x, int y, int width, const Color *colors) {
+  uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * SSD1351_BYTESPERPIXEL;
+  for (int i = 0; i < width; i++) {
+    const uint32_t color565 = display::ColorUtil::color_to_565(colors[i]);
+    *dst++ = (color565 >> 8) & 0xff;
+    *dst++ = color565 & 0xff;
+  }
+}
 void SSD1351::fill(Color color) {
   const uint32_t color565 = display::ColorUtil::color_to_565(color);
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
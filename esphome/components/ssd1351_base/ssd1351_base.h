@@ -38,6 +38,8 @@ class SSD1351 : public PollingComponent, public display::DisplayBuffer {
   void init_reset_();
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_row_internal(int x, int y, int width, const Color *colors) override;
 
   int get_height_internal() override;
   int get_width_internal() override;
@@ -285,6 +285,7 @@ void ST7735::setup() {
 
   this->init_internal_(this->get_buffer_length());
   memset(this->buffer_, 0x00, this->get_buffer_length());
+  this->init_dirty_tiles_(this->eightbitcolor_ ? 8 : 16);
 }
 
 void ST7735::update() {
@@ -319,6 +320,34 @@ void HOT ST7735::draw_absolute_pixel_internal(int x, int y, Color color) {
   }
 }
 
+void HOT ST7735::fill_span_internal(int x, int y, int width, Color color) {
+  if (this->eightbitcolor_) {
+    memset(this->buffer_ + x + y * this->get_width_internal(), display::ColorUtil::color_to_332(color), width);
+  } else {
+    const uint32_t color565 = display::ColorUtil::color_to_565(color);
+    uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+    for (int i = 0; i < width; i++) {
+      *dst++ = (color565 >> 8) & 0xff;
+      *dst++ = color565 & 0xff;
+    }
+  }
+}
+
+void HOT ST7735::blit_row_internal(int x, int y, int width, const Color *colors) {
+  if (this->eightbitcolor_) {
+    uint8_t *dst = this->buffer_ + x + y * this->get_width_internal();
+    for (int i = 0; i < width; i++)
+      dst[i] = display::ColorUtil::color_to_332(colors[i]);
+  } else {
+    uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+    for (int i = 0; i < width; i++) {
+      const uint32_t color565 = display::ColorUtil::color_to_565(colors[i]);
+      *dst++ = (color565 >> 8) & 0xff;
+      *dst++ = color565 & 0xff;
+    }
+  }
+}
+
 void ST7735::init_reset_() {
   if (this->reset_pin_ != nullptr) {
     this->reset_pin_->setup();
@@ -413,14 +442,17 @@ void HOT ST7735::senddata_(const uint8_t *data_bytes, uint8_t num_data_bytes) {
   this->disable();
 }
 
-void HOT ST7735::write_display_data_() {
-  uint16_t offsetx = colstart_;
-  uint16_t offsety = rowstart_;
+void ST7735::write_display_data_() {
+  // only send the parts of the buffer that changed since the last update
+  for (auto &region : this->get_dirty_regions_())
+    this->write_region_(region);
+}
 
-  uint16_t x1 = offsetx;
-  uint16_t x2 = x1 + get_width_internal() - 1;
-  uint16_t y1 = offsety;
-  uint16_t y2 = y1 + get_height_internal() - 1;
+void HOT ST7735::write_region_(const display::DisplayRegion &region) {
+  uint16_t x1 = colstart_ + region.x;
+  uint16_t x2 = x1 + region.width - 1;
+  uint16_t y1 = rowstart_ + region.y;
+  uint16_t y2 = y1 + region.height - 1;
 
   this->enable();
 
@@ -441,20 +473,30 @@ void HOT ST7735::write_display_data_() {
   this->write_byte(ST77XX_RAMWR);
   this->dc_pin_->digital_write(true);
 
+  const int width = this->get_width_internal();
   if (this->eightbitcolor_) {
-    for (int line = 0; line < this->get_buffer_length(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
-        auto color332 = display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
+    if (this->line_buffer_ == nullptr)
+      this->line_buffer_.reset(new uint8_t[width * 2]);
+    uint8_t *line = this->line_buffer_.get();
+    for (int row = region.y; row < region.y + region.height; row++) {
+      const uint8_t *src = this->buffer_ + row * width + region.x;
+      for (int index = 0; index < region.width; ++index) {
+        auto color332 = display::ColorUtil::to_color(src[index], display::ColorOrder::COLOR_ORDER_RGB,
                                                      display::ColorBitness::COLOR_BITNESS_332, true);
 
         auto color = display::ColorUtil::color_to_565(color332);
 
-        this->write_byte((color >> 8) & 0xff);
-        this->write_byte(color & 0xff);
+        line[index * 2] = (color >> 8) & 0xff;
+        line[index * 2 + 1] = color & 0xff;
       }
+      this->write_array(line, region.width * 2);
     }
+  } else if (region.width == width) {
+    // full rows are contiguous in the buffer
+    this->write_array(this->buffer_ + region.y * width * 2, region.height * width * 2);
   } else {
-    this->write_array(this->buffer_, this->get_buffer_length());
+    for (int row = region.y; row < region.y + region.height; row++)
+      this->write_array(this->buffer_ + (row * width + region.x) * 2, region.width * 2);
   }
   this->disable();
 }
@@ -60,11 +60,14 @@ class ST7735 : public PollingComponent,
   void writedata_(uint8_t value);
 
   void write_display_data_();
+  void write_region_(const display::DisplayRegion &region);
 
   void init_reset_();
   void display_init_(const uint8_t *addr);
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_row_internal(int x, int y, int width, const Color *colors) override;
   void spi_master_write_addr_(uint16_t addr1, uint16_t addr2);
   void spi_master_write_color_(uint16_t color, uint16_t size);
 
@@ -78,6 +81,8 @@ class ST7735 : public PollingComponent,
   boolean eightbitcolor_ = false;
   boolean usebgr_ = false;
   int16_t width_ = 80, height_ = 80;  // Watch heap size
+  /// One row converted to 16 bit color in eight bit mode, allocated on the first update.
+  std::unique_ptr<uint8_t[]> line_buffer_;
 
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *dc_pin_{nullptr};
@@ -270,5 +270,23 @@ void HOT ST7789V::draw_absolute_pixel_internal(int x, int y, Color color) {
   this->buffer_[pos] = color565 & 0xff;
 }
 
+void HOT ST7789V::fill_span_internal(int x, int y, int width, Color color) {
+  auto color565 = display::ColorUtil::color_to_565(color);
+  uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+  for (int i = 0; i < width; i++) {
+    *dst++ = (color565 >> 8) & 0xff;
+    *dst++ = color565 & 0xff;
+  }
+}
+
+void HOT ST7789V::blit_row_internal(int x, int y, int width, const Color *colors) {
+  uint8_t *dst = this->buffer_ + (x + y * this->get_width_internal()) * 2;
+  for (int i = 0; i < width; i++) {
+    auto color565 = display::ColorUtil::color_to_565(colors[i]);
+    *dst++ = (color565 >> 8) & 0xff;
+    *dst++ = color565 & 0xff;
+  }
+}
+
 }  // namespace st7789v
 }  // namespace esphome
@@ -145,6 +145,8 @@ class ST7789V : public PollingComponent,
   void draw_filled_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_row_internal(int x, int y, int width, const Color *colors) override;
 };
 
 }  // namespace st7789v
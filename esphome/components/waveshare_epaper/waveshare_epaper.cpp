@@ -3,6 +3,8 @@
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace waveshare_epaper {
 
@@ -125,6 +127,11 @@ bool WaveshareEPaper::wait_until_idle_() {
 }
 void WaveshareEPaper::update() {
   this->do_update_();
+  // a refresh takes seconds, don't start one for a frame the panel already shows
+  if (this->get_dirty_regions_().empty()) {
+    ESP_LOGV(TAG, "Frame unchanged, skipping refresh");
+    return;
+  }
   this->display();
 }
 void WaveshareEPaper::fill(Color color) {
@@ -145,6 +152,34 @@ void HOT WaveshareEPaper::draw_absolute_pixel_internal(int x, int y, Color color
   else
     this->buffer_[pos] &= ~(0x80 >> subpos);
 }
+void HOT WaveshareEPaper::fill_span_internal(int x, int y, int width, Color color) {
+  // whole bytes in the middle, masks for the partial bytes at either end
+  const uint32_t start = x + y * this->get_width_internal();
+  const uint32_t end = start + width;
+  uint32_t pos = start / 8u;
+  const uint32_t last = (end - 1) / 8u;
+  const uint8_t first_mask = 0xFF >> (start & 0x07);
+  const uint8_t last_mask = 0xFF << (7 - ((end - 1) & 0x07));
+  const bool set = !color.is_on();
+  if (pos == last) {
+    const uint8_t mask = first_mask & last_mask;
+    this->buffer_[pos] = set ? this->buffer_[pos] | mask : this->buffer_[pos] & ~mask;
+    return;
+  }
+  this->buffer_[pos] = set ? this->buffer_[pos] | first_mask : this->buffer_[pos] & ~first_mask;
+  if (last > pos + 1)
+    memset(this->buffer_ + pos + 1, set ? 0xFF : 0x00, last - pos - 1);
+  this->buffer_[last] = set ? this->buffer_[last] | last_mask : this->buffer_[last] & ~last_mask;
+}
+void HOT WaveshareEPaper::blit_row_internal(int x, int y, int width, const Color *colors) {
+  uint32_t bit = x + y * this->get_width_internal();
+  for (int i = 0; i < width; i++, bit++) {
+    if (!colors[i].is_on())
+      this->buffer_[bit / 8u] |= 0x80 >> (bit & 0x07);
+    else
+      this->buffer_[bit / 8u] &= ~(0x80 >> (bit & 0x07));
+  }
+}
 uint32_t WaveshareEPaper::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal() / 8u; }
 void WaveshareEPaper::start_command_() {
   this->dc_pin_->digital_write(false);
@@ -241,6 +276,7 @@ void HOT WaveshareEPaperTypeA::display() {
 
   if (!this->wait_until_idle_()) {
     this->status_set_warning();
+    this->invalidate_dirty_tiles_();
     return;
   }
 
@@ -263,27 +299,82 @@ void HOT WaveshareEPaperTypeA::display() {
     this->at_update_ = (this->at_update_ + 1) % this->full_update_every_;
   }
 
-  // Set x & y regions we want to write to (full)
+  const uint16_t height = this->get_height_internal();
+  if (full_update) {
+    if (!this->write_rows_(0, height)) {
+      this->status_set_warning();
+      this->invalidate_dirty_tiles_();
+      return;
+    }
+    // the other RAM bank is still out of date, so the next partial update writes everything again
+    this->last_bands_.clear();
+    this->last_bands_.push_back(display::DisplayRegion{0, 0, 0, height});
+  } else {
+    // changed bands of this frame plus the ones written last time, merged where they touch
+    std::vector<display::DisplayRegion> bands = this->dirty_regions_;
+    bands.insert(bands.end(), this->last_bands_.begin(), this->last_bands_.end());
+    std::sort(bands.begin(), bands.end(),
+              [](const display::DisplayRegion &a, const display::DisplayRegion &b) { return a.y < b.y; });
+    uint16_t rows = 0;
+    for (size_t i = 0; i < bands.size();) {
+      uint16_t y = bands[i].y, end = bands[i].y + bands[i].height;
+      for (i++; i < bands.size() && bands[i].y <= end; i++)
+        end = std::max<uint16_t>(end, bands[i].y + bands[i].height);
+      if (!this->write_rows_(y, end - y)) {
+        this->status_set_warning();
+        this->invalidate_dirty_tiles_();
+        return;
+      }
+      rows += end - y;
+    }
+    ESP_LOGV(TAG, "Partial update of %u rows", rows);
+    this->last_bands_ = this->dirty_regions_;
+  }
+
+  // COMMAND DISPLAY UPDATE CONTROL 2
+  this->command(0x22);
+  if (this->model_ == WAVESHARE_EPAPER_2_9_IN_V2) {
+    this->data(full_update ? 0xF7 : 0xFF);
+  } else if (this->model_ == TTGO_EPAPER_2_13_IN_B73) {
+    this->data(0xC7);
+  } else {
+    this->data(0xC4);
+  }
+
+  // COMMAND MASTER ACTIVATION
+  this->command(0x20);
+  // COMMAND TERMINATE FRAME READ WRITE
+  this->command(0xFF);
+
+  this->status_clear_warning();
+}
+bool WaveshareEPaperTypeA::write_rows_(int y, int height) {
+  const uint16_t first = y;
+  const uint16_t last = y + height - 1;
+  const uint32_t row_bytes = this->get_width_internal() / 8u;
+
+  // Set x & y regions we want to write to
   switch (this->model_) {
     case TTGO_EPAPER_2_13_IN_B1:
+      // y decreases in this data entry mode, start at the last row
       // COMMAND SET RAM X ADDRESS START END POSITION
       this->command(0x44);
       this->data(0x00);
       this->data((this->get_width_internal() - 1) >> 3);
       // COMMAND SET RAM Y ADDRESS START END POSITION
       this->command(0x45);
-      this->data(this->get_height_internal() - 1);
-      this->data((this->get_height_internal() - 1) >> 8);
-      this->data(0x00);
-      this->data(0x00);
+      this->data(last);
+      this->data(last >> 8);
+      this->data(first);
+      this->data(first >> 8);
 
       // COMMAND SET RAM X ADDRESS COUNTER
       this->command(0x4E);
       this->data(0x00);
       // COMMAND SET RAM Y ADDRESS COUNTER
       this->command(0x4F);
-      this->data(this->get_height_internal() - 1);
-      this->data((this->get_height_internal() - 1) >> 8);
+      this->data(last);
+      this->data(last >> 8);
 
       break;
 
@@ -294,60 +385,34 @@ void HOT WaveshareEPaperTypeA::display() {
       this->data((this->get_width_internal() - 1) >> 3);
       // COMMAND SET RAM Y ADDRESS START END POSITION
       this->command(0x45);
-      this->data(0x00);
-      this->data(0x00);
-      this->data(this->get_height_internal() - 1);
-      this->data((this->get_height_internal() - 1) >> 8);
+      this->data(first);
+      this->data(first >> 8);
+      this->data(last);
+      this->data(last >> 8);
 
       // COMMAND SET RAM X ADDRESS COUNTER
       this->command(0x4E);
       this->data(0x00);
       // COMMAND SET RAM Y ADDRESS COUNTER
       this->command(0x4F);
-      this->data(0x00);
-      this->data(0x00);
+      this->data(first);
+      this->data(first >> 8);
   }
 
-  if (!this->wait_until_idle_()) {
-    this->status_set_warning();
-    return;
-  }
+  if (!this->wait_until_idle_())
+    return false;
 
   // COMMAND WRITE RAM
   this->command(0x24);
   this->start_data_();
-  switch (this->model_) {
-    case TTGO_EPAPER_2_13_IN_B1: {  // block needed because of variable initializations
-      int16_t wb = ((this->get_width_internal()) >> 3);
-      for (int i = 0; i < this->get_height_internal(); i++) {
-        for (int j = 0; j < wb; j++) {
-          int idx = j + (this->get_height_internal() - 1 - i) * wb;
-          this->write_byte(this->buffer_[idx]);
-        }
-      }
-      break;
-    }
-    default:
-      this->write_array(this->buffer_, this->get_buffer_length_());
-  }
-  this->end_data_();
-
-  // COMMAND DISPLAY UPDATE CONTROL 2
-  this->command(0x22);
-  if (this->model_ == WAVESHARE_EPAPER_2_9_IN_V2) {
-    this->data(full_update ? 0xF7 : 0xFF);
-  } else if (this->model_ == TTGO_EPAPER_2_13_IN_B73) {
-    this->data(0xC7);
+  if (this->model_ == TTGO_EPAPER_2_13_IN_B1) {
+    for (int row = last; row >= first; row--)
+      this->write_array(this->buffer_ + row * row_bytes, row_bytes);
   } else {
-    this->data(0xC4);
+    this->write_array(this->buffer_ + first * row_bytes, height * row_bytes);
   }
-
-  // COMMAND MASTER ACTIVATION
-  this->command(0x20);
-  // COMMAND TERMINATE FRAME READ WRITE
-  this->command(0xFF);
-
-  this->status_clear_warning();
+  this->end_data_();
+  return true;
 }
 int WaveshareEPaperTypeA::get_width_internal() {
   switch (this->model_) {
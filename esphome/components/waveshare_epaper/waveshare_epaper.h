@@ -4,6 +4,8 @@
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
 
+#include <vector>
+
 namespace esphome {
 namespace waveshare_epaper {
 
@@ -31,12 +33,16 @@ class WaveshareEPaper : public PollingComponent,
   void setup() override {
     this->setup_pins_();
     this->initialize();
+    // compare the frame against the last transmitted one in full width bands of eight rows
+    this->init_dirty_tiles_(1, this->get_width_internal(), 8);
   }
 
   void on_safe_shutdown() override;
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_span_internal(int x, int y, int width, Color color) override;
+  void blit_row_internal(int x, int y, int width, const Color *colors) override;
 
   bool wait_until_idle_();
 
@@ -100,6 +106,8 @@ class WaveshareEPaperTypeA : public WaveshareEPaper {
 
  protected:
   void write_lut_(const uint8_t *lut, uint8_t size);
+  /// Set the RAM window to rows y to y + height - 1 and write them to the controller.
+  bool write_rows_(int y, int height);
 
   int get_width_internal() override;
 
@@ -107,6 +115,12 @@ class WaveshareEPaperTypeA : public WaveshareEPaper {
 
   uint32_t full_update_every_{30};
   uint32_t at_update_{0};
+  /** Rows written by the previous update.
+   *
+   * Some controllers alternate between two RAM banks after each refresh, so a partial update writes these rows
+   * again to bring the other bank up to date.
+   */
+  std::vector<display::DisplayRegion> last_bands_;
   WaveshareEPaperTypeAModel model_;
   int idle_timeout_() override;
 };
@@ -255,13 +255,13 @@ void WebServer::handle_sensor_request(AsyncWebServerRequest *request, UrlMatch m
   request->send(404);
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "sensor-" + obj->get_object_id();
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "sensor-" + obj->get_object_id());
     std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
     if (!obj->get_unit_of_measurement().empty())
       state += " " + obj->get_unit_of_measurement();
-    root["state"] = state;
-    root["value"] = value;
+    root.add("state", state);
+    root.add("value", value);
   });
 }
 #endif
@@ -283,10 +283,10 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, UrlMa
   request->send(404);
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "text_sensor-" + obj->get_object_id();
-    root["state"] = value;
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "text_sensor-" + obj->get_object_id());
+    root.add("state", value);
+    root.add("value", value);
   });
 }
 #endif
@@ -296,10 +296,10 @@ void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
   this->events_.send(this->switch_json(obj, state).c_str(), "state");
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "switch-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "switch-" + obj->get_object_id());
+    root.add("state", value ? "ON" : "OFF");
+    root.add("value", value);
   });
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, UrlMatch match) {
@@ -337,10 +337,10 @@ void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool s
   this->events_.send(this->binary_sensor_json(obj, state).c_str(), "state");
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "binary_sensor-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
+  return json::write_json([obj, value](json::JsonWriter &root) {
+    root.add("id", "binary_sensor-" + obj->get_object_id());
+    root.add("state", value ? "ON" : "OFF");
+    root.add("value", value);
   });
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, UrlMatch match) {
@@ -364,27 +364,27 @@ void WebServer::on_fan_update(fan::FanState *obj) {
   this->events_.send(this->fan_json(obj).c_str(), "state");
 }
 std::string WebServer::fan_json(fan::FanState *obj) {
-  return json::build_json([obj](JsonObject &root) {
-    root["id"] = "fan-" + obj->get_object_id();
-    root["state"] = obj->state ? "ON" : "OFF";
-    root["value"] = obj->state;
+  return json::write_json([obj](json::JsonWriter &root) {
+    root.add("id", "fan-" + obj->get_object_id());
+    root.add("state", obj->state ? "ON" : "OFF");
+    root.add("value", obj->state);
     const auto traits = obj->get_traits();
     if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
+      root.add("speed_level", obj->speed);
       switch (fan::speed_level_to_enum(obj->speed, traits.supported_speed_count())) {
         case fan::FAN_SPEED_LOW:
-          root["speed"] = "low";
+          root.add("speed", "low");
           break;
         case fan::FAN_SPEED_MEDIUM:
-          root["speed"] = "medium";
+          root.add("speed", "medium");
           break;
         case fan::FAN_SPEED_HIGH:
-          root["speed"] = "high";
+          root.add("speed", "high");
           break;
       }
     }
     if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
+      root.add("oscillation", obj->oscillating);
   });
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, UrlMatch match) {
@@ -572,14 +572,14 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, UrlMatch ma
   request->send(404);
 }
 std::string WebServer::cover_json(cover::Cover *obj) {
-  return json::build_json([obj](JsonObject &root) {
-    root["id"] = "cover-" + obj->get_object_id();
-    root["state"] = obj->is_fully_closed() ? "CLOSED" : "OPEN";
-    root["value"] = obj->position;
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
+  return json::write_json([obj](json::JsonWriter &root) {
+    root.add("id", "cover-" + obj->get_object_id());
+    root.add("state", obj->is_fully_closed() ? "CLOSED" : "OPEN");
+    root.add("value", obj->position);
+    root.add("current_operation", cover::cover_operation_to_str(obj->current_operation));
 
     if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
+      root.add("tilt", obj->tilt);
   });
 }
 #endif
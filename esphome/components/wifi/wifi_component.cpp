@@ -131,6 +131,9 @@ void WiFiComponent::loop() {
   }
 
   network_tick_mdns();
+  // a lost connection and the timeouts above are still noticed in time when checking at most once per second
+  this->set_loop_idle(this->state_ == WIFI_COMPONENT_STATE_STA_CONNECTED || this->state_ == WIFI_COMPONENT_STATE_AP ||
+                      this->state_ == WIFI_COMPONENT_STATE_OFF);
 }
 
 WiFiComponent::WiFiComponent() { global_wifi_component = this; }
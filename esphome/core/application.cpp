@@ -7,10 +7,19 @@
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#ifdef USE_RUNTIME_STATS
+#include "esphome/components/runtime_stats/runtime_stats.h"
+#endif
+
 namespace esphome {
 
 static const char *TAG = "app";
 
+#ifdef USE_EVENT_DRIVEN_LOOP
+/// Upper bound for sleeping when no component needs to be polled, so the watchdog is fed regularly.
+static const uint32_t EVENT_LOOP_MAX_SLEEP = 1000;
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -59,6 +68,9 @@ void Application::setup() {
   ESP_LOGI(TAG, "setup() finished successfully!");
   this->schedule_dump_config();
   this->calculate_looping_components_();
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(ARDUINO_ARCH_ESP32)
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+#endif
 
   // Dummy function to link some symbols into the binary.
   force_link_symbols();
@@ -67,17 +79,51 @@ void Application::loop() {
   uint32_t new_app_state = 0;
   const uint32_t start = millis();
 
+#ifdef USE_RUNTIME_STATS
+  Component *slowest = nullptr;
+  uint32_t slowest_time = 0;
+#endif
+
+#ifdef USE_EVENT_DRIVEN_LOOP
+  if (this->has_pending_enable_loop_requests_)
+    this->enable_pending_loops_();
+#endif
+
   this->scheduler.call();
-  for (Component *component : this->looping_components_) {
+  this->in_loop_ = true;
+  for (this->current_loop_index_ = 0; this->current_loop_index_ < this->looping_components_active_end_;
+       this->current_loop_index_++) {
+    Component *component = this->looping_components_[this->current_loop_index_];
+#ifdef USE_RUNTIME_STATS
+    const uint32_t component_start = micros();
+#endif
     component->call();
+#ifdef USE_RUNTIME_STATS
+    const uint32_t component_time = micros() - component_start;
+    runtime_stats::global_runtime_stats->record_component(component, component_time);
+    if (component_time > slowest_time) {
+      slowest = component;
+      slowest_time = component_time;
+    }
+#endif
     new_app_state |= component->get_component_state();
     this->app_state_ |= new_app_state;
     this->feed_wdt();
   }
+  this->in_loop_ = false;
+  // components with a disabled loop can still have a warning or error status
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++)
+    new_app_state |= this->looping_components_[i]->get_component_state();
   this->app_state_ = new_app_state;
 
   const uint32_t end = millis();
   if (end - start > 200) {
+#ifdef USE_RUNTIME_STATS
+    if (slowest != nullptr) {
+      ESP_LOGW(TAG, "A loop() cycle took %.2f s, slowest component was '%s' (%.2f ms).", (end - start) / 1e3f,
+               slowest->get_component_source(), slowest_time / 1e3f);
+    }
+#endif
     ESP_LOGV(TAG, "A component took a long time in a loop() cycle (%.2f s).", (end - start) / 1e3f);
     ESP_LOGV(TAG, "Components should block for at most 20-30ms in loop().");
   }
@@ -96,7 +142,17 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
+#ifdef USE_EVENT_DRIVEN_LOOP
+    const bool dumping_config = this->dump_config_at_ >= 0 && size_t(this->dump_config_at_) < this->components_.size();
+    if (this->active_loops_idle_() && !dumping_config) {
+      // Nothing but polling left, sleep until the next scheduler item is due or a component is woken up
+      delay_time = this->scheduler.next_schedule_in().value_or(EVENT_LOOP_MAX_SLEEP);
+      delay_time = std::min(delay_time, EVENT_LOOP_MAX_SLEEP);
+    }
+    this->wait_for_wake_(delay_time);
+#else
     delay(delay_time);
+#endif
   }
   this->last_loop_ = now;
 
@@ -152,12 +208,99 @@ void Application::safe_reboot() {
 }
 
 void Application::calculate_looping_components_() {
+  // components that disabled their loop during setup() go to the inactive part at the end
+  for (auto *obj : this->components_) {
+    if (obj->has_overridden_loop() && !obj->is_loop_disabled())
+      this->looping_components_.push_back(obj);
+  }
+  this->looping_components_active_end_ = this->looping_components_.size();
   for (auto *obj : this->components_) {
-    if (obj->has_overridden_loop())
+    if (obj->has_overridden_loop() && obj->is_loop_disabled())
       this->looping_components_.push_back(obj);
   }
 }
 
+void ICACHE_RAM_ATTR Application::wake_loop_any_context() {
+#ifdef USE_EVENT_DRIVEN_LOOP
+  this->wake_requested_ = true;
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->main_task_ == nullptr)
+    return;
+  if (xPortInIsrContext()) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(this->main_task_, &higher_priority_task_woken);
+    if (higher_priority_task_woken == pdTRUE)
+      portYIELD_FROM_ISR();
+  } else {
+    xTaskNotifyGive(this->main_task_);
+  }
+#endif
+#endif
+}
+
+#ifdef USE_EVENT_DRIVEN_LOOP
+void Application::disable_component_loop_(Component *component) {
+  for (size_t i = 0; i < this->looping_components_active_end_; i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // move to the front of the inactive part, keeping the order of the active components
+    std::rotate(this->looping_components_.begin() + i, this->looping_components_.begin() + i + 1,
+                this->looping_components_.begin() + this->looping_components_active_end_);
+    this->looping_components_active_end_--;
+    // the components after i moved one to the front, don't skip the one now at the current index
+    if (this->in_loop_ && i <= this->current_loop_index_)
+      this->current_loop_index_--;
+    return;
+  }
+}
+void Application::enable_component_loop_(Component *component) {
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // move to the end of the active part, runs later in the current cycle if we're in one
+    std::rotate(this->looping_components_.begin() + this->looping_components_active_end_,
+                this->looping_components_.begin() + i, this->looping_components_.begin() + i + 1);
+    this->looping_components_active_end_++;
+    return;
+  }
+}
+void Application::enable_pending_loops_() {
+  // clear first, so that requests coming in while scanning are handled in the next cycle
+  this->has_pending_enable_loop_requests_ = false;
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    Component *component = this->looping_components_[i];
+    if (!component->pending_enable_loop_)
+      continue;
+    component->pending_enable_loop_ = false;
+    component->enable_loop();
+  }
+}
+bool Application::active_loops_idle_() const {
+  for (size_t i = 0; i < this->looping_components_active_end_; i++) {
+    if (!this->looping_components_[i]->is_loop_idle())
+      return false;
+  }
+  return true;
+}
+void Application::wait_for_wake_(uint32_t delay_time) {
+  if (!this->wake_requested_) {
+#ifdef ARDUINO_ARCH_ESP32
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(delay_time));
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+    // delay() can't be interrupted, so sleep in small steps and check for a wake request in between
+    const uint32_t start = millis();
+    while (!this->wake_requested_ && millis() - start < delay_time)
+      delay(1);
+#endif
+  } else {
+    yield();
+  }
+  this->wake_requested_ = false;
+  this->feed_wdt();
+}
+#endif
+
 Application App;
 
 }  // namespace esphome
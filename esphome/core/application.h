@@ -114,6 +114,14 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /** Wake the main loop if it is sleeping between two loop() cycles.
+   *
+   * Safe to call from ISRs and other tasks. Only has an effect with the event-driven loop
+   * (USE_EVENT_DRIVEN_LOOP), where the application sleeps until the next scheduler item is due
+   * if no component needs to be polled.
+   */
+  void wake_loop_any_context();
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -215,8 +223,28 @@ class Application {
 
   void calculate_looping_components_();
 
+#ifdef USE_EVENT_DRIVEN_LOOP
+  void disable_component_loop_(Component *component);
+  void enable_component_loop_(Component *component);
+  void enable_pending_loops_();
+  /// Whether all components whose loop() is still called declared themselves idle.
+  bool active_loops_idle_() const;
+  void wait_for_wake_(uint32_t delay_time);
+#endif
+
   std::vector<Component *> components_{};
+  /// Components with a loop(), those in [0, looping_components_active_end_) currently get called.
   std::vector<Component *> looping_components_{};
+  size_t looping_components_active_end_{0};
+  size_t current_loop_index_{0};
+  bool in_loop_{false};
+#ifdef USE_EVENT_DRIVEN_LOOP
+  volatile bool has_pending_enable_loop_requests_{false};
+  volatile bool wake_requested_{false};
+#ifdef ARDUINO_ARCH_ESP32
+  TaskHandle_t main_task_{nullptr};
+#endif
+#endif
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
@@ -46,18 +46,34 @@ void Component::set_interval(const std::string &name, uint32_t interval, std::fu
   App.scheduler.set_interval(this, name, interval, std::move(f));
 }
 
+void Component::set_interval(const char *name, uint32_t interval, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_interval(this, name, interval, std::move(f));
+}
+
 bool Component::cancel_interval(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_interval(this, name);
 }
 
+bool Component::cancel_interval(const char *name) {  // NOLINT
+  return App.scheduler.cancel_interval(this, name);
+}
+
 void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
   return App.scheduler.set_timeout(this, name, timeout, std::move(f));
 }
 
+void Component::set_timeout(const char *name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, name, timeout, std::move(f));
+}
+
 bool Component::cancel_timeout(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
 
+bool Component::cancel_timeout(const char *name) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, name);
+}
+
 void Component::call_loop() { this->loop(); }
 
 void Component::call_setup() { this->setup(); }
@@ -100,9 +116,15 @@ void Component::defer(std::function<void()> &&f) {  // NOLINT
 bool Component::cancel_defer(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
+bool Component::cancel_defer(const char *name) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, name);
+}
 void Component::defer(const std::string &name, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
+void Component::defer(const char *name, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, name, 0, std::move(f));
+}
 void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, "", timeout, std::move(f));
 }
@@ -152,6 +174,35 @@ bool Component::has_overridden_loop() const {
 #endif
   return loop_overridden || call_loop_overridden;
 }
+void Component::disable_loop() {
+#ifdef USE_EVENT_DRIVEN_LOOP
+  if (this->loop_disabled_)
+    return;
+  this->loop_disabled_ = true;
+  App.disable_component_loop_(this);
+#endif
+}
+void Component::enable_loop() {
+#ifdef USE_EVENT_DRIVEN_LOOP
+  if (!this->loop_disabled_)
+    return;
+  this->loop_disabled_ = false;
+  App.enable_component_loop_(this);
+#endif
+}
+void ICACHE_RAM_ATTR Component::enable_loop_soon_any_context() {
+#ifdef USE_EVENT_DRIVEN_LOOP
+  // only set flags here, the looping components are rearranged by the main loop
+  this->pending_enable_loop_ = true;
+  App.has_pending_enable_loop_requests_ = true;
+  App.wake_loop_any_context();
+#endif
+}
+const char *Component::get_component_source() const {
+  if (this->component_source_ == nullptr)
+    return "<unknown>";
+  return this->component_source_;
+}
 
 PollingComponent::PollingComponent(uint32_t update_interval) : Component(), update_interval_(update_interval) {}
 
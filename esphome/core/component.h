@@ -128,7 +128,47 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() until enable_loop() or enable_loop_soon_any_context() is called.
+   *
+   * Only takes effect with the event-driven main loop, otherwise loop() keeps being called every cycle.
+   * Components using this must re-enable their loop whenever new work arrives.
+   */
+  void disable_loop();
+
+  /// Resume calling loop() every cycle. Must be called from the main loop.
+  void enable_loop();
+
+  /** Resume calling loop() from any context, including ISRs and other tasks.
+   *
+   * The request is picked up at the start of the next cycle and wakes the main loop if it is sleeping.
+   */
+  void enable_loop_soon_any_context();
+
+  bool is_loop_disabled() const { return this->loop_disabled_; }
+
+  /** Declare whether loop() is only polling for changes right now, for components that can't use disable_loop().
+   *
+   * loop() is still called every cycle. But once all components that are still being looped are idle, the
+   * event-driven main loop sleeps until the next scheduler item is due or a wake request comes in, at most one second.
+   */
+  void set_loop_idle(bool idle) { this->loop_idle_ = idle; }
+
+  bool is_loop_idle() const { return this->loop_idle_; }
+
+  /** Set the source of this component, usually the configuration ID.
+   *
+   * Used by diagnostics such as runtime_stats to attribute time to a component.
+   *
+   * @param source The static string identifying this component, must outlive the component.
+   */
+  void set_component_source(const char *source) { this->component_source_ = source; }
+
+  /// Get the source of this component, or "<unknown>" if none was set.
+  const char *get_component_source() const;
+
  protected:
+  friend class Application;
+
   virtual void call_loop();
   virtual void call_setup();
   /** Set an interval function with a unique name. Empty name means no cancelling possible.
@@ -148,6 +188,9 @@ class Component {
    */
   void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);  // NOLINT
 
+  /// Same as above, but avoids constructing a std::string for literal names.
+  void set_interval(const char *name, uint32_t interval, std::function<void()> &&f);  // NOLINT
+
   void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
 
   /** Cancel an interval function.
@@ -156,6 +199,7 @@ class Component {
    * @return Whether an interval functions was deleted.
    */
   bool cancel_interval(const std::string &name);  // NOLINT
+  bool cancel_interval(const char *name);         // NOLINT
 
   void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
@@ -175,12 +219,16 @@ class Component {
    */
   void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
+  /// Same as above, but avoids constructing a std::string for literal names.
+  void set_timeout(const char *name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
   /** Cancel a timeout function.
    *
    * @param name The identifier for this timeout function.
    * @return Whether a timeout functions was deleted.
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
+  bool cancel_timeout(const char *name);         // NOLINT
 
   /** Defer a callback to the next loop() call.
    *
@@ -190,15 +238,21 @@ class Component {
    * @param f The callback.
    */
   void defer(const std::string &name, std::function<void()> &&f);  // NOLINT
+  void defer(const char *name, std::function<void()> &&f);         // NOLINT
 
   /// Defer a callback to the next loop() call.
   void defer(std::function<void()> &&f);  // NOLINT
 
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
+  bool cancel_defer(const char *name);         // NOLINT
 
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
+  const char *component_source_{nullptr};
+  bool loop_disabled_{false};
+  bool loop_idle_{false};
+  volatile bool pending_enable_loop_{false};
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -317,6 +317,7 @@ template<typename T> class Parented {
 };
 
 uint32_t fnv1_hash(const std::string &str);
+uint32_t fnv1_hash(const char *str);
 
 }  // namespace esphome
 
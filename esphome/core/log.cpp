@@ -9,6 +9,12 @@
 namespace esphome {
 
 void HOT esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
+#ifdef USE_LOGGER
+  // filter before touching the arguments
+  auto *log = logger::global_logger;
+  if (log == nullptr || level > log->level_for(tag))
+    return;
+#endif
   va_list arg;
   va_start(arg, format);
   esp_log_vprintf_(level, tag, line, format, arg);
@@ -16,6 +22,11 @@ void HOT esp_log_printf_(int level, const char *tag, int line, const char *forma
 }
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 void HOT esp_log_printf_(int level, const char *tag, int line, const __FlashStringHelper *format, ...) {
+#ifdef USE_LOGGER
+  auto *log = logger::global_logger;
+  if (log == nullptr || level > log->level_for(tag))
+    return;
+#endif
   va_list arg;
   va_start(arg, format);
   esp_log_vprintf_(level, tag, line, format, arg);
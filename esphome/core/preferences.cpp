@@ -2,6 +2,9 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
+#include "esphome/core/preferences_flash_log.h"
+
+#include <algorithm>
 
 #ifdef ARDUINO_ARCH_ESP8266
 extern "C" {
@@ -100,6 +103,37 @@ static const uint32_t get_esp8266_flash_sector() {
 }
 static const uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
 
+#ifdef USE_ESP8266_PREFERENCES_FLASH_LOG
+extern "C" uint32_t _SPIFFS_start;
+
+static FlashLogStore esp8266_flash_log;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+bool flash_log_erase_sector(uint32_t sector) {
+  InterruptLock lock;
+  return spi_flash_erase_sector(sector) == SPI_FLASH_RESULT_OK;
+}
+bool flash_log_write(uint32_t address, const uint32_t *data, size_t words) {
+  InterruptLock lock;
+  return spi_flash_write(address, const_cast<uint32_t *>(data), words * 4) == SPI_FLASH_RESULT_OK;
+}
+bool flash_log_read(uint32_t address, uint32_t *data, size_t words) {
+  InterruptLock lock;
+  return spi_flash_read(address, data, words * 4) == SPI_FLASH_RESULT_OK;
+}
+
+/// The log ends in the sector used by the single sector layout and extends into the unused SPIFFS area before it.
+static uint8_t get_esp8266_flash_log_sectors() {
+  union {
+    uint32_t *ptr;
+    uint32_t uint;
+  } start{}, end{};
+  start.ptr = &_SPIFFS_start;
+  end.ptr = &_SPIFFS_end;
+  uint32_t available = (end.uint - start.uint) / SPI_FLASH_SEC_SIZE + 1;
+  return std::min<uint32_t>(ESP8266_PREFERENCES_FLASH_LOG_SECTORS, available);
+}
+#endif
+
 void ESPPreferences::save_esp8266_flash_() {
   if (!esp8266_flash_dirty)
     return;
@@ -126,6 +160,30 @@ void ESPPreferences::save_esp8266_flash_() {
 }
 
 bool ESPPreferenceObject::save_internal_() {
+#ifdef USE_ESP8266_PREFERENCES_FLASH_LOG
+  if (this->in_flash_) {
+    if (this->offset_ + this->length_words_ >= ESP8266_FLASH_STORAGE_SIZE)
+      return false;
+    // only append the words that actually changed
+    uint32_t *storage = &global_preferences.flash_storage_[this->offset_];
+    int32_t first = -1, last = -1;
+    for (uint32_t i = 0; i <= this->length_words_; i++) {
+      if (storage[i] == this->data_[i])
+        continue;
+      if (first < 0)
+        first = i;
+      last = i;
+      storage[i] = this->data_[i];
+    }
+    if (first < 0)
+      return true;
+    if (!esp8266_flash_log.write(this->offset_ + first, last - first + 1)) {
+      ESP_LOGV(TAG, "Write ESP8266 flash log failed!");
+      return false;
+    }
+    return true;
+  }
+#else
   if (this->in_flash_) {
     for (uint32_t i = 0; i <= this->length_words_; i++) {
       uint32_t j = this->offset_ + i;
@@ -140,6 +198,7 @@ bool ESPPreferenceObject::save_internal_() {
     global_preferences.save_esp8266_flash_();
     return true;
   }
+#endif
 
   for (uint32_t i = 0; i <= this->length_words_; i++) {
     if (!esp_rtc_user_mem_write(this->offset_ + i, this->data_[i]))
@@ -176,6 +235,15 @@ void ESPPreferences::begin() {
   this->flash_storage_ = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];
   ESP_LOGVV(TAG, "Loading preferences from flash...");
 
+#ifdef USE_ESP8266_PREFERENCES_FLASH_LOG
+  uint8_t sectors = get_esp8266_flash_log_sectors();
+  if (esp8266_flash_log.init(get_esp8266_flash_sector() + 1 - sectors, sectors, this->flash_storage_,
+                             ESP8266_FLASH_STORAGE_SIZE)) {
+    ESP_LOGV(TAG, "Loaded flash log (sequence %u, %u sectors)", esp8266_flash_log.get_sequence(), sectors);
+    return;
+  }
+  // no log yet, pick up the single sector layout; the first save starts the log
+#endif
   {
     InterruptLock lock;
     spi_flash_read(get_esp8266_flash_address(), this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
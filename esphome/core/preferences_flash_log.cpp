@@ -0,0 +1,122 @@
+#include "esphome/core/preferences_flash_log.h"
+
+#ifdef USE_ESP8266_PREFERENCES_FLASH_LOG
+
+#include <memory>
+
+namespace esphome {
+
+static const uint32_t HEADER_WORDS = 2;
+static const uint32_t ERASED = 0xFFFFFFFF;
+
+uint32_t FlashLogStore::checksum_(uint32_t header, const uint32_t *data, size_t length) {
+  // FNV-1a over the words, never equal to erased flash
+  uint32_t hash = (2166136261UL ^ header) * 16777619UL;
+  for (size_t i = 0; i < length; i++)
+    hash = (hash ^ data[i]) * 16777619UL;
+  return hash == ERASED ? 0 : hash;
+}
+
+bool FlashLogStore::init(uint32_t first_sector, uint8_t sector_count, uint32_t *storage, size_t storage_words) {
+  this->first_sector_ = first_sector;
+  this->sector_count_ = sector_count;
+  this->storage_ = storage;
+  this->storage_words_ = storage_words;
+  this->active_ = sector_count;
+  this->write_offset_ = SECTOR_SIZE;
+
+  for (uint8_t i = 0; i < sector_count; i++) {
+    uint32_t header[HEADER_WORDS];
+    if (!flash_log_read(this->sector_address_(i), header, HEADER_WORDS) || header[0] != MAGIC)
+      continue;
+    if (this->active_ == sector_count || int32_t(header[1] - this->sequence_) > 0) {
+      this->active_ = i;
+      this->sequence_ = header[1];
+    }
+  }
+  if (this->active_ == sector_count)
+    return false;
+
+  // every sector starts with a full snapshot, so replaying the newest one is enough
+  this->write_offset_ = this->replay_(this->active_);
+  return true;
+}
+
+uint32_t FlashLogStore::replay_(uint8_t index) {
+  const uint32_t base = this->sector_address_(index);
+  std::unique_ptr<uint32_t[]> record(new uint32_t[this->storage_words_ + 1]);
+  uint32_t offset = HEADER_WORDS * 4;
+  while (offset + 4 <= SECTOR_SIZE) {
+    uint32_t header;
+    if (!flash_log_read(base + offset, &header, 1))
+      return SECTOR_SIZE;
+    if (header == ERASED)
+      return offset;
+
+    const uint32_t start = header >> 16;
+    const uint32_t length = header & 0xFFFF;
+    const uint32_t record_size = (length + 2) * 4;
+    if (length == 0 || start + length > this->storage_words_ || offset + record_size > SECTOR_SIZE)
+      // torn or foreign data, nothing after it can be trusted; the next write compacts
+      return SECTOR_SIZE;
+    if (!flash_log_read(base + offset + 4, record.get(), length + 1))
+      return SECTOR_SIZE;
+    if (record[length] != checksum_(header, record.get(), length))
+      return SECTOR_SIZE;
+
+    for (uint32_t i = 0; i < length; i++)
+      this->storage_[start + i] = record[i];
+    offset += record_size;
+  }
+  return offset;
+}
+
+bool FlashLogStore::write(size_t offset, size_t length) {
+  if (length == 0)
+    return true;
+  if (this->active_ == this->sector_count_ || this->write_offset_ + (length + 2) * 4 > SECTOR_SIZE)
+    // the snapshot already contains the new words
+    return this->compact_();
+  return this->append_(offset, length);
+}
+
+bool FlashLogStore::append_(size_t offset, size_t length) {
+  const uint32_t header = (uint32_t(offset) << 16) | uint32_t(length);
+  const uint32_t address = this->sector_address_(this->active_) + this->write_offset_;
+  // header, data and checksum in one go keeps the record contiguous
+  std::unique_ptr<uint32_t[]> record(new uint32_t[length + 2]);
+  record[0] = header;
+  for (size_t i = 0; i < length; i++)
+    record[i + 1] = this->storage_[offset + i];
+  record[length + 1] = checksum_(header, &this->storage_[offset], length);
+  this->write_offset_ += (length + 2) * 4;
+  if (!flash_log_write(address, record.get(), length + 2)) {
+    // the record may be partially written, start over in a fresh sector
+    this->write_offset_ = SECTOR_SIZE;
+    return false;
+  }
+  return true;
+}
+
+bool FlashLogStore::compact_() {
+  const uint8_t next = this->active_ == this->sector_count_ ? 0 : (this->active_ + 1) % this->sector_count_;
+  if (!flash_log_erase_sector(this->first_sector_ + next))
+    return false;
+
+  this->active_ = next;
+  this->write_offset_ = HEADER_WORDS * 4;
+  if (!this->append_(0, this->storage_words_))
+    return false;
+  // with a single sector the old contents are already gone, otherwise this commits the switch
+  const uint32_t header[HEADER_WORDS] = {MAGIC, this->sequence_ + 1};
+  if (!flash_log_write(this->sector_address_(next), header, HEADER_WORDS)) {
+    this->write_offset_ = SECTOR_SIZE;
+    return false;
+  }
+  this->sequence_++;
+  return true;
+}
+
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_ESP8266_PREFERENCES_FLASH_LOG
+
+namespace esphome {
+
+/// Flash access for FlashLogStore, addresses and sizes are 4-byte aligned. Provided by the platform.
+bool flash_log_erase_sector(uint32_t sector);
+bool flash_log_write(uint32_t address, const uint32_t *data, size_t words);
+bool flash_log_read(uint32_t address, uint32_t *data, size_t words);
+
+/** Append-only preference storage spread over a ring of flash sectors.
+ *
+ * The preference words live in a RAM mirror. Every save appends a record with only the changed words to the
+ * active sector, so a sector is erased once it is full instead of on every save. When the active sector is full,
+ * the next sector in the ring is erased and starts with a snapshot of the whole mirror, followed by its header.
+ * The header is written last, so a power loss during this compaction leaves the previous sector in charge.
+ *
+ * Sector layout: magic, sequence number, records. Record layout: (offset << 16 | length), length data words,
+ * checksum. Erased flash (0xFFFFFFFF) ends the log, a record with a bad checksum ends it early.
+ */
+class FlashLogStore {
+ public:
+  static const uint32_t SECTOR_SIZE = 4096;
+  static const uint32_t MAGIC = 0x474F4C50;  // "PLOG"
+
+  /** Load the mirror from the newest valid sector.
+   *
+   * @param first_sector First absolute flash sector of the ring.
+   * @param sector_count Number of consecutive sectors in the ring.
+   * @param storage RAM mirror of the preferences.
+   * @param storage_words Size of the mirror, at most a sector minus header and record overhead.
+   * @return false if no sector holds a valid log, the mirror is left untouched then.
+   */
+  bool init(uint32_t first_sector, uint8_t sector_count, uint32_t *storage, size_t storage_words);
+
+  /// Persist words [offset, offset + length) of the mirror.
+  bool write(size_t offset, size_t length);
+
+  uint8_t get_sector_count() const { return this->sector_count_; }
+  uint32_t get_sequence() const { return this->sequence_; }
+
+ protected:
+  static uint32_t checksum_(uint32_t header, const uint32_t *data, size_t length);
+  uint32_t sector_address_(uint8_t index) const { return (this->first_sector_ + index) * SECTOR_SIZE; }
+  bool append_(size_t offset, size_t length);
+  /// Continue in the next sector of the ring, starting with a snapshot of the mirror.
+  bool compact_();
+  /// Replay the records of a sector into the mirror, returns the offset after the last valid record.
+  uint32_t replay_(uint8_t index);
+
+  uint32_t first_sector_{0};
+  uint8_t sector_count_{0};
+  /// Index of the sector records are appended to, sector_count_ if there is none yet.
+  uint8_t active_{0};
+  /// Byte offset of the next record in the active sector.
+  uint32_t write_offset_{SECTOR_SIZE};
+  uint32_t sequence_{0};
+  uint32_t *storage_{nullptr};
+  size_t storage_words_{0};
+};
+
+}  // namespace esphome
+
+#endif
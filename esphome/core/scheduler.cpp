@@ -3,75 +3,389 @@
 #include "esphome/core/helpers.h"
 #include <algorithm>
 
+#ifdef USE_RUNTIME_STATS
+#include "esphome/components/runtime_stats/runtime_stats.h"
+#endif
+
 namespace esphome {
 
 static const char *TAG = "scheduler";
 
 static const uint32_t SCHEDULER_DONT_RUN = 4294967295UL;
+#ifndef USE_SCHEDULER_TIMER_WHEEL
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+#endif
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> &&func) {
-  const uint32_t now = this->millis_();
-
-  if (!name.empty())
-    this->cancel_timeout(component, name);
-
-  if (timeout == SCHEDULER_DONT_RUN)
-    return;
-
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
-
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::TIMEOUT;
-  item->timeout = timeout;
-  item->last_execution = now;
-  item->last_execution_major = this->millis_major_;
-  item->f = std::move(func);
-  item->remove = false;
-  this->push_(std::move(item));
+  this->set_timeout(component, name.c_str(), timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout(Component *component, const char *name, uint32_t timeout,
+                                std::function<void()> &&func) {
+  this->set_timer_(component, hash_name_(name), name, SchedulerItem::TIMEOUT, timeout, std::move(func));
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+  return this->cancel_timeout(component, name.c_str());
+}
+bool HOT Scheduler::cancel_timeout(Component *component, const char *name) {
+  return this->cancel_item_(component, hash_name_(name), name, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> &&func) {
+  this->set_interval(component, name.c_str(), interval, std::move(func));
+}
+void HOT Scheduler::set_interval(Component *component, const char *name, uint32_t interval,
+                                 std::function<void()> &&func) {
+  this->set_timer_(component, hash_name_(name), name, SchedulerItem::INTERVAL, interval, std::move(func));
+}
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_interval(component, name.c_str());
+}
+bool HOT Scheduler::cancel_interval(Component *component, const char *name) {
+  return this->cancel_item_(component, hash_name_(name), name, SchedulerItem::INTERVAL);
+}
+uint32_t Scheduler::hash_name_(const char *name) {
+  if (name == nullptr || *name == '\0')
+    return 0;
+  // 0 is reserved for unnamed items
+  const uint32_t hash = fnv1_hash(name);
+  return hash != 0 ? hash : 1;
+}
+void HOT Scheduler::set_timer_(Component *component, uint32_t name_hash, const char *name,
+                               SchedulerItem::Type type, uint32_t delay, std::function<void()> &&func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (name_hash != 0)
+    this->cancel_item_(component, name_hash, name, type);
 
-  if (interval == SCHEDULER_DONT_RUN)
+  if (delay == SCHEDULER_DONT_RUN)
     return;
 
   // only put offset in lower half
   uint32_t offset = 0;
-  if (interval != 0)
-    offset = (random_uint32() % interval) / 2;
+  if (type == SchedulerItem::INTERVAL && delay != 0)
+    offset = (random_uint32() % delay) / 2;
 
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
+  if (type == SchedulerItem::INTERVAL) {
+    ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name, delay, offset);
+  } else {
+    ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name, delay);
+  }
 
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+  SchedulerItem *item = this->acquire_();
+#else
   auto item = make_unique<SchedulerItem>();
+#endif
   item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::INTERVAL;
-  item->interval = interval;
-  item->last_execution = now - offset - interval;
-  item->last_execution_major = this->millis_major_;
-  if (item->last_execution > now)
-    item->last_execution_major--;
+  item->name_hash = name_hash;
+  if (name_hash != 0) {
+    item->name = name;
+  } else {
+    item->name.clear();
+  }
+  item->type = type;
+  item->interval = delay;
   item->f = std::move(func);
   item->remove = false;
+
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+  const uint64_t now64 = (uint64_t(this->millis_major_) << 32) | now;
+  if (type == SchedulerItem::INTERVAL) {
+    // intervals run for the first time on the next call, shifted back by the offset
+    item->deadline = now64 > offset ? now64 - offset : 0;
+  } else {
+    item->deadline = now64 + delay;
+  }
+  item->next = nullptr;
+  item->pprev = nullptr;
+  item->index_next = nullptr;
+  if (name_hash != 0) {
+    SchedulerItem **bucket = this->index_bucket_(component, name_hash);
+    item->index_next = *bucket;
+    *bucket = item;
+  }
+  this->to_add_.push_back(item);
+#else
+  if (type == SchedulerItem::INTERVAL) {
+    item->last_execution = now - offset - delay;
+    item->last_execution_major = this->millis_major_;
+    if (item->last_execution > now)
+      item->last_execution_major--;
+  } else {
+    item->last_execution = now;
+    item->last_execution_major = this->millis_major_;
+  }
   this->push_(std::move(item));
+#endif
 }
-bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+uint32_t Scheduler::millis_() {
+  const uint32_t now = millis();
+  if (now < this->last_millis_) {
+    ESP_LOGD(TAG, "Incrementing scheduler major");
+    this->millis_major_++;
+  }
+  this->last_millis_ = now;
+  return now;
+}
+
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+
+optional<uint32_t> HOT Scheduler::next_schedule_in() {
+  if (!this->due_.empty())
+    return 0;
+  if (this->wheel_count_ == 0)
+    return {};
+
+  // Every item in a wheel slot expires at or after the time that slot is reached (or cascaded), so the
+  // earliest populated slot across all levels is a lower bound for the next execution.
+  uint64_t next = UINT64_MAX;
+  for (uint8_t level = 0; level < WHEEL_LEVELS; level++) {
+    const uint8_t shift = WHEEL_BITS * level;
+    const uint64_t base = this->current_tick_ >> shift;
+    for (uint32_t k = 1; k <= WHEEL_SLOTS; k++) {
+      if (this->wheel_[level][(base + k) & WHEEL_MASK] != nullptr) {
+        next = std::min(next, (base + k) << shift);
+        break;
+      }
+    }
+  }
+  if (this->overflow_ != nullptr) {
+    const uint8_t shift = WHEEL_BITS * WHEEL_LEVELS;
+    next = std::min(next, ((this->current_tick_ >> shift) + 1) << shift);
+  }
+
+  const uint64_t now = this->now64_();
+  if (next <= now)
+    return 0;
+  return uint32_t(std::min<uint64_t>(next - now, UINT32_MAX - 1));
+}
+void ICACHE_RAM_ATTR HOT Scheduler::call() {
+  const uint64_t now = this->now64_();
+  this->process_to_add();
+  this->advance_(now);
+
+  // Items (re-)added while executing are staged in to_add_ and only become due in the next call,
+  // so this list cannot grow while it is being processed.
+  for (auto *item : this->due_) {
+    if (item->remove) {
+      this->release_(item);
+      continue;
+    }
+
+    // Don't run on failed components
+    if (item->component != nullptr && item->component->is_failed()) {
+      this->release_(item);
+      continue;
+    }
+
+#ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+    const char *type = item->type == SchedulerItem::INTERVAL ? "interval" : "timeout";
+    ESP_LOGVV(TAG, "Running %s '%s' with interval=%u (now=%u)", type, item->name.c_str(), item->interval,
+              uint32_t(now));
+#endif
+
+    // Warning: During f(), timeouts/intervals get added or cancelled, including this one.
+#ifdef USE_RUNTIME_STATS
+    const uint32_t start = micros();
+    item->f();
+    runtime_stats::global_runtime_stats->record_scheduler(item->component, item->name_hash, item->name,
+                                                          micros() - start);
+#else
+    item->f();
+#endif
+
+    if (item->remove) {
+      // We were cancelled in the function call, stop
+      this->release_(item);
+      continue;
+    }
+
+    if (item->type == SchedulerItem::INTERVAL) {
+      if (item->interval != 0) {
+        const uint64_t elapsed = now > item->deadline ? now - item->deadline : 0;
+        const uint64_t amount = elapsed / item->interval + 1;
+        item->deadline += amount * item->interval;
+      }
+      this->to_add_.push_back(item);
+    } else {
+      this->release_(item);
+    }
+  }
+  this->due_.clear();
+
+  this->process_to_add();
+}
+void HOT Scheduler::process_to_add() {
+  if (this->wheel_count_ == 0) {
+    // Empty wheel, fast-forward so new items don't have to be walked through stale ticks
+    this->current_tick_ = std::max(this->current_tick_, this->now64_());
+  }
+
+  for (auto *item : this->to_add_) {
+    if (item->remove) {
+      this->release_(item);
+      continue;
+    }
+    this->wheel_insert_(item);
+  }
+  this->to_add_.clear();
+}
+bool HOT Scheduler::cancel_item_(Component *component, uint32_t name_hash, const char *name,
+                                 Scheduler::SchedulerItem::Type type) {
+  if (name_hash == 0)
+    return false;
+
+  bool ret = false;
+  SchedulerItem **link = this->index_bucket_(component, name_hash);
+  while (*link != nullptr) {
+    SchedulerItem *item = *link;
+    // different names can share a hash, the name decides
+    if (item->component != component || item->name_hash != name_hash || item->type != type || item->name != name) {
+      link = &item->index_next;
+      continue;
+    }
+
+    *link = item->index_next;
+    item->index_next = nullptr;
+    item->remove = true;
+    ret = true;
+    if (item->pprev != nullptr) {
+      // Waiting in the wheel, can be recycled right away. Items that are due, running or
+      // staged are released once they are reached.
+      this->unlink_(item);
+      this->release_(item);
+    }
+  }
+  return ret;
+}
+uint64_t Scheduler::now64_() {
+  const uint32_t now = this->millis_();
+  return (uint64_t(this->millis_major_) << 32) | now;
+}
+Scheduler::SchedulerItem *HOT Scheduler::acquire_() {
+  if (this->pool_ == nullptr) {
+    this->pool_.reset(new SchedulerItem[SCHEDULER_POOL_SIZE]);
+    for (size_t i = 0; i < SCHEDULER_POOL_SIZE; i++) {
+      this->pool_[i].next = this->free_;
+      this->free_ = &this->pool_[i];
+    }
+  }
+
+  SchedulerItem *item = this->free_;
+  if (item == nullptr) {
+    // Pool exhausted, grow it. Items are never freed, so the pool settles at the high-water mark.
+    ESP_LOGV(TAG, "Scheduler pool exhausted, allocating new item");
+    return new SchedulerItem();
+  }
+  this->free_ = item->next;
+  return item;
+}
+void HOT Scheduler::release_(SchedulerItem *item) {
+  if (item->name_hash != 0 && !item->remove)
+    this->index_remove_(item);
+  // Destroy captured state now instead of when the item is reused
+  item->f = nullptr;
+  item->pprev = nullptr;
+  item->next = this->free_;
+  this->free_ = item;
 }
+void HOT Scheduler::link_(SchedulerItem **head, SchedulerItem *item) {
+  item->next = *head;
+  if (item->next != nullptr)
+    item->next->pprev = &item->next;
+  *head = item;
+  item->pprev = head;
+  this->wheel_count_++;
+}
+void HOT Scheduler::unlink_(SchedulerItem *item) {
+  *item->pprev = item->next;
+  if (item->next != nullptr)
+    item->next->pprev = item->pprev;
+  item->next = nullptr;
+  item->pprev = nullptr;
+  this->wheel_count_--;
+}
+void HOT Scheduler::wheel_insert_(SchedulerItem *item) {
+  if (item->deadline <= this->current_tick_) {
+    this->due_.push_back(item);
+    return;
+  }
+
+  const uint64_t delta = item->deadline - this->current_tick_;
+  SchedulerItem **head = &this->overflow_;
+  for (uint8_t level = 0; level < WHEEL_LEVELS; level++) {
+    const uint8_t shift = WHEEL_BITS * level;
+    if (delta < (1ULL << (shift + WHEEL_BITS))) {
+      head = &this->wheel_[level][(item->deadline >> shift) & WHEEL_MASK];
+      break;
+    }
+  }
+  this->link_(head, item);
+}
+void HOT Scheduler::cascade_(SchedulerItem **head) {
+  // Detach the whole list first, overflow items may be re-inserted into the same list
+  SchedulerItem *item = *head;
+  *head = nullptr;
+  while (item != nullptr) {
+    SchedulerItem *next = item->next;
+    item->next = nullptr;
+    item->pprev = nullptr;
+    this->wheel_count_--;
+    this->wheel_insert_(item);
+    item = next;
+  }
+}
+void HOT Scheduler::advance_(uint64_t now) {
+  while (this->current_tick_ < now) {
+    if (this->wheel_count_ == 0) {
+      // Nothing left to cascade or expire
+      this->current_tick_ = now;
+      break;
+    }
+
+    const uint64_t tick = ++this->current_tick_;
+
+    // Count the levels whose slot boundary is crossed by this tick and cascade them top-down,
+    // so that items trickle down to level 0 before it is expired.
+    uint8_t levels = 0;
+    while (levels < WHEEL_LEVELS && (tick & ((1ULL << (WHEEL_BITS * (levels + 1))) - 1)) == 0)
+      levels++;
+    if (levels == WHEEL_LEVELS)
+      this->cascade_(&this->overflow_);
+    for (uint8_t level = std::min<uint8_t>(levels, WHEEL_LEVELS - 1); level >= 1; level--)
+      this->cascade_(&this->wheel_[level][(tick >> (WHEEL_BITS * level)) & WHEEL_MASK]);
+
+    SchedulerItem **head = &this->wheel_[0][tick & WHEEL_MASK];
+    while (*head != nullptr) {
+      SchedulerItem *item = *head;
+      this->unlink_(item);
+      this->due_.push_back(item);
+    }
+  }
+}
+Scheduler::SchedulerItem **Scheduler::index_bucket_(Component *component, uint32_t name_hash) {
+  uint32_t hash = name_hash ^ uint32_t(reinterpret_cast<uintptr_t>(component) >> 2);
+  hash ^= hash >> 16;
+  return &this->index_[hash % INDEX_BUCKETS];
+}
+void HOT Scheduler::index_remove_(SchedulerItem *item) {
+  SchedulerItem **link = this->index_bucket_(item->component, item->name_hash);
+  while (*link != nullptr) {
+    if (*link == item) {
+      *link = item->index_next;
+      item->index_next = nullptr;
+      return;
+    }
+    link = &(*link)->index_next;
+  }
+}
+
+#else  // USE_SCHEDULER_TIMER_WHEEL
+
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
   if (this->empty_())
     return {};
@@ -155,7 +469,16 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
       // Warning: During f(), a lot of stuff can happen, including:
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
+#ifdef USE_RUNTIME_STATS
+      // item is a reference into items_, which may be reallocated during f()
+      SchedulerItem *raw_item = item.get();
+      const uint32_t start = micros();
+      raw_item->f();
+      runtime_stats::global_runtime_stats->record_scheduler(raw_item->component, raw_item->name_hash, raw_item->name,
+                                                            micros() - start);
+#else
       item->f();
+#endif
     }
 
     {
@@ -213,31 +536,27 @@ void HOT Scheduler::pop_raw_() {
   this->items_.pop_back();
 }
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) { this->to_add_.push_back(std::move(item)); }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+bool HOT Scheduler::cancel_item_(Component *component, uint32_t name_hash, const char *name,
+                                 Scheduler::SchedulerItem::Type type) {
+  if (name_hash == 0)
+    return false;
+
   bool ret = false;
   for (auto &it : this->items_)
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
+    if (it->component == component && it->name_hash == name_hash && it->type == type && !it->remove &&
+        it->name == name) {
       to_remove_++;
       it->remove = true;
       ret = true;
     }
   for (auto &it : this->to_add_)
-    if (it->component == component && it->name == name && it->type == type) {
+    if (it->component == component && it->name_hash == name_hash && it->type == type && it->name == name) {
       it->remove = true;
       ret = true;
     }
 
   return ret;
 }
-uint32_t Scheduler::millis_() {
-  const uint32_t now = millis();
-  if (now < this->last_millis_) {
-    ESP_LOGD(TAG, "Incrementing scheduler major");
-    this->millis_major_++;
-  }
-  this->last_millis_ = now;
-  return now;
-}
 
 bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
                                        const std::unique_ptr<SchedulerItem> &b) {
@@ -268,4 +587,6 @@ bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
   return a_next_exec > b_next_exec;
 }
 
+#endif  // USE_SCHEDULER_TIMER_WHEEL
+
 }  // namespace esphome
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/log.h"
 #include <vector>
 #include <memory>
 
@@ -8,12 +10,22 @@ namespace esphome {
 
 class Component;
 
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+#ifndef SCHEDULER_POOL_SIZE
+#define SCHEDULER_POOL_SIZE 16
+#endif
+#endif
+
 class Scheduler {
  public:
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func);
+  void set_timeout(Component *component, const char *name, uint32_t timeout, std::function<void()> &&func);
   bool cancel_timeout(Component *component, const std::string &name);
+  bool cancel_timeout(Component *component, const char *name);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> &&func);
+  void set_interval(Component *component, const char *name, uint32_t interval, std::function<void()> &&func);
   bool cancel_interval(Component *component, const std::string &name);
+  bool cancel_interval(Component *component, const char *name);
 
   optional<uint32_t> next_schedule_in();
 
@@ -24,15 +36,27 @@ class Scheduler {
  protected:
   struct SchedulerItem {
     Component *component;
+    /// FNV-1 hash of the name, 0 for unnamed (non-cancellable) items. Checked before comparing the name.
+    uint32_t name_hash;
     std::string name;
     enum Type { TIMEOUT, INTERVAL } type;
     union {
       uint32_t interval;
       uint32_t timeout;
     };
-    uint32_t last_execution;
     std::function<void()> f;
     bool remove;
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+    /// Absolute execution time in ms, extended to 64 bits with the scheduler major.
+    uint64_t deadline;
+    /// Next item in the wheel slot, overflow or free list.
+    SchedulerItem *next;
+    /// Pointer to the link pointing at this item, nullptr if not linked in the wheel.
+    SchedulerItem **pprev;
+    /// Next item in the cancel index bucket.
+    SchedulerItem *index_next;
+#else
+    uint32_t last_execution;
     uint8_t last_execution_major;
 
     inline uint32_t next_execution() { return this->last_execution + this->timeout; }
@@ -45,13 +69,50 @@ class Scheduler {
     }
 
     static bool cmp(const std::unique_ptr<SchedulerItem> &a, const std::unique_ptr<SchedulerItem> &b);
+#endif
   };
 
+  static uint32_t hash_name_(const char *name);
+  void set_timer_(Component *component, uint32_t name_hash, const char *name, SchedulerItem::Type type,
+                  uint32_t delay, std::function<void()> &&func);
   uint32_t millis_();
+  bool cancel_item_(Component *component, uint32_t name_hash, const char *name, SchedulerItem::Type type);
+
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+  /// log2 of the slots per wheel level, level 0 has a resolution of 1ms and 4 levels cover ~17 minutes.
+  static const uint8_t WHEEL_BITS = 5;
+  static const uint32_t WHEEL_SLOTS = 1UL << WHEEL_BITS;
+  static const uint32_t WHEEL_MASK = WHEEL_SLOTS - 1;
+  static const uint8_t WHEEL_LEVELS = 4;
+  static const uint8_t INDEX_BUCKETS = 32;
+
+  uint64_t now64_();
+  SchedulerItem *acquire_();
+  void release_(SchedulerItem *item);
+  void link_(SchedulerItem **head, SchedulerItem *item);
+  void unlink_(SchedulerItem *item);
+  void wheel_insert_(SchedulerItem *item);
+  void cascade_(SchedulerItem **head);
+  void advance_(uint64_t now);
+  SchedulerItem **index_bucket_(Component *component, uint32_t name_hash);
+  void index_remove_(SchedulerItem *item);
+
+  SchedulerItem *wheel_[WHEEL_LEVELS][WHEEL_SLOTS]{};
+  /// Items scheduled further in the future than the wheel can represent.
+  SchedulerItem *overflow_{nullptr};
+  /// Named items by (component, name hash) for O(1) cancellation.
+  SchedulerItem *index_[INDEX_BUCKETS]{};
+  SchedulerItem *free_{nullptr};
+  std::unique_ptr<SchedulerItem[]> pool_;
+  /// Expired items waiting to be executed, in order of expiry.
+  std::vector<SchedulerItem *> due_;
+  std::vector<SchedulerItem *> to_add_;
+  uint64_t current_tick_{0};
+  uint32_t wheel_count_{0};
+#else
   void cleanup_();
   void pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -59,9 +120,10 @@ class Scheduler {
 
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  uint32_t to_remove_{0};
+#endif
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
-  uint32_t to_remove_{0};
 };
 
 }  // namespace esphome
@@ -22,6 +22,7 @@ from esphome.const import (
     CONF_PLATFORMIO_OPTIONS,
     CONF_PRIORITY,
     CONF_TRIGGER_ID,
+    CONF_TYPE,
     CONF_ESP8266_RESTORE_FROM_FLASH,
     ARDUINO_VERSION_ESP8266,
     ARDUINO_VERSION_ESP32,
@@ -46,6 +47,13 @@ LoopTrigger = cg.esphome_ns.class_(
 VERSION_REGEX = re.compile(r"^[0-9]+\.[0-9]+\.[0-9]+(?:[ab]\d+)?$")
 
 CONF_NAME_ADD_MAC_SUFFIX = "name_add_mac_suffix"
+CONF_SCHEDULER = "scheduler"
+CONF_POOL_SIZE = "pool_size"
+CONF_EVENT_DRIVEN_LOOP = "event_driven_loop"
+CONF_LIGHT_FIXED_POINT = "light_fixed_point"
+CONF_ESP8266_PREFERENCES_LOG_SECTORS = "esp8266_preferences_log_sectors"
+
+SCHEDULER_TYPES = ["heap", "timer_wheel"]
 
 
 def validate_board(value):
@@ -154,6 +162,9 @@ CONFIG_SCHEMA = cv.Schema(
         cv.SplitDefault(CONF_ESP8266_RESTORE_FROM_FLASH, esp8266=False): cv.All(
             cv.only_on_esp8266, cv.boolean
         ),
+        cv.SplitDefault(CONF_ESP8266_PREFERENCES_LOG_SECTORS, esp8266=0): cv.All(
+            cv.only_on_esp8266, cv.int_range(min=0, max=16)
+        ),
         cv.SplitDefault(CONF_BOARD_FLASH_MODE, esp8266="dout"): cv.one_of(
             *BUILD_FLASH_MODES, lower=True
         ),
@@ -176,6 +187,19 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
         cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
         cv.Optional(CONF_NAME_ADD_MAC_SUFFIX, default=False): cv.boolean,
+        cv.Optional(CONF_SCHEDULER, default={}): cv.Schema(
+            {
+                cv.Optional(CONF_TYPE, default="heap"): cv.one_of(
+                    *SCHEDULER_TYPES, lower=True
+                ),
+                cv.Optional(CONF_POOL_SIZE, default=16): cv.int_range(
+                    min=1, max=1024
+                ),
+            }
+        ),
+        cv.Optional(CONF_EVENT_DRIVEN_LOOP, default=False): cv.boolean,
+        # the ESP8266 has no FPU, run light transitions and gamma correction in fixed point there
+        cv.SplitDefault(CONF_LIGHT_FIXED_POINT, esp8266=True, esp32=False): cv.boolean,
         cv.Optional("esphome_core_version"): cv.invalid(
             "The esphome_core_version option has been "
             "removed in 1.13 - the esphome core source "
@@ -326,6 +350,24 @@ def to_code(config):
     cg.add_build_flag("-Wno-sign-compare")
     if config.get(CONF_ESP8266_RESTORE_FROM_FLASH, False):
         cg.add_define("USE_ESP8266_PREFERENCES_FLASH")
+    if config.get(CONF_ESP8266_PREFERENCES_LOG_SECTORS, 0) > 0:
+        cg.add_define("USE_ESP8266_PREFERENCES_FLASH_LOG")
+        cg.add_define(
+            "ESP8266_PREFERENCES_FLASH_LOG_SECTORS",
+            config[CONF_ESP8266_PREFERENCES_LOG_SECTORS],
+        )
+
+    scheduler = config[CONF_SCHEDULER]
+    if scheduler[CONF_TYPE] == "timer_wheel":
+        cg.add_define("USE_SCHEDULER_TIMER_WHEEL")
+        cg.add_define("SCHEDULER_POOL_SIZE", scheduler[CONF_POOL_SIZE])
+
+    if config[CONF_EVENT_DRIVEN_LOOP]:
+        cg.add_define("USE_EVENT_DRIVEN_LOOP")
+
+    if config[CONF_LIGHT_FIXED_POINT]:
+        # all lights store their color values the same way, so this can't be chosen per light
+        cg.add_define("USE_LIGHT_FIXED_POINT")
 
     if config[CONF_INCLUDES]:
         CORE.add_job(add_includes, config[CONF_INCLUDES])
@@ -171,6 +171,17 @@ class TypeInfo:
 
     encode_func = None
 
+    @property
+    def size_func(self):
+        # encode_enum<T> -> ProtoSize::add_enum_field<T>
+        name, sep, template = self.encode_func.partition("<")
+        name = name.replace("encode_", "add_", 1)
+        return f"ProtoSize::{name}_field{sep}{template}"
+
+    @property
+    def calculate_size_content(self):
+        return f"{self.size_func}(total_size, {self.number}, this->{self.field_name});"
+
     @property
     def dump_content(self):
         o = f'out.append("  {self.name}: ");\n'
@@ -239,7 +250,7 @@ class UInt64Type(TypeInfo):
     encode_func = "encode_uint64"
 
     def dump(self, name):
-        o = f'sprintf(buffer, "%ull", {name});\n'
+        o = f'sprintf(buffer, "%llu", {name});\n'
         o += f"out.append(buffer);"
         return o
 
@@ -265,7 +276,7 @@ class Fixed64Type(TypeInfo):
     encode_func = "encode_fixed64"
 
     def dump(self, name):
-        o = f'sprintf(buffer, "%ull", {name});\n'
+        o = f'sprintf(buffer, "%llu", {name});\n'
         o += f"out.append(buffer);"
         return o
 
@@ -519,6 +530,13 @@ class RepeatedTypeInfo(TypeInfo):
           buffer.{self._ti.encode_func}({self.number}, it, true);
         }}"""
 
+    @property
+    def calculate_size_content(self):
+        return f"""\
+        for (auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{
+          {self._ti.size_func}(total_size, {self.number}, it, true);
+        }}"""
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -556,6 +574,7 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    calculate_size = []
     dump = []
 
     for field in desc.field:
@@ -566,6 +585,7 @@ def build_message_type(desc):
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        calculate_size.append(ti.calculate_size_content)
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -627,6 +647,13 @@ def build_message_type(desc):
     prot = "void encode(ProtoWriteBuffer buffer) const override;"
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{\n"
+    o += indent("\n".join(calculate_size)) + "\n"
+    o += "}\n"
+    cpp += o
+    prot = "void calculate_size(uint32_t &total_size) const override;"
+    public_content.append(prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{\n"
     if dump:
         o += f"  char buffer[64];\n"